@@ -0,0 +1,160 @@
+/**
+ * bench/bench_Components.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench_components.hpp"
+
+#include <benchmark/benchmark.h>
+
+template <size_t Components>
+static void BM_AttachComponent(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    registerBenchComponents(world, std::make_index_sequence<Components>());
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<vazel::ecs::Entity> entities = populate<0>(world, count);
+        state.ResumeTiming();
+        for (auto &e : entities) {
+            attachBenchComponents(world, e,
+                                  std::make_index_sequence<Components>());
+        }
+        state.PauseTiming();
+        for (auto &e : entities) {
+            world.removeEntity(e);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count * Components);
+}
+BENCHMARK_TEMPLATE(BM_AttachComponent, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_AttachComponent, 4)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_AttachComponent, 8)->VAZEL_BENCH_ENTITIES;
+
+template <size_t Components>
+static void BM_DetachComponent(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    registerBenchComponents(world, std::make_index_sequence<Components>());
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<vazel::ecs::Entity> entities =
+            populate<Components>(world, count);
+        state.ResumeTiming();
+        for (auto &e : entities) {
+            detachBenchComponents(world, e,
+                                  std::make_index_sequence<Components>());
+        }
+        state.PauseTiming();
+        for (auto &e : entities) {
+            world.removeEntity(e);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count * Components);
+}
+BENCHMARK_TEMPLATE(BM_DetachComponent, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_DetachComponent, 4)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_DetachComponent, 8)->VAZEL_BENCH_ENTITIES;
+
+template <size_t Components>
+static void BM_GetComponent(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    registerBenchComponents(world, std::make_index_sequence<Components>());
+    std::vector<vazel::ecs::Entity> entities =
+        populate<Components>(world, count);
+
+    for (auto _ : state) {
+        for (auto &e : entities) {
+            benchmark::DoNotOptimize(
+                world.getComponent<bench_component<Components - 1>>(e));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_GetComponent, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_GetComponent, 4)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_GetComponent, 8)->VAZEL_BENCH_ENTITIES;
+
+/**
+ * @brief Join a component on every entity with one on 1 entity in 1000, the
+ * common one stored densely and the rare one with Storage
+ *
+ */
+template <vazel::ecs::ComponentStorage Storage>
+static void BM_JoinRare(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    world.registerComponent<bench_component<0>>(
+        vazel::ecs::ComponentStorage::Dense);
+    world.registerComponent<bench_component<1>>(Storage);
+    for (size_t i = 0; i != count; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+
+        world.attachComponent<bench_component<0>>(e);
+        if (i % 1000 == 0) {
+            world.attachComponent<bench_component<1>>(e);
+        }
+    }
+    for (auto _ : state) {
+        world.join<bench_component<0>, bench_component<1>>(
+            [](const vazel::ecs::Entity &, bench_component<0> &a,
+               bench_component<1> &b) { a.value[0] += b.value[0]; });
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_JoinRare, vazel::ecs::ComponentStorage::Dense)
+    ->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_JoinRare, vazel::ecs::ComponentStorage::Sparse)
+    ->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_JoinRare, vazel::ecs::ComponentStorage::Paged)
+    ->VAZEL_BENCH_ENTITIES;
+
+/**
+ * @brief Join two components on every entity, both stored with Storage
+ *
+ */
+template <vazel::ecs::ComponentStorage Storage>
+static void BM_JoinCommon(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    world.registerComponent<bench_component<0>>(Storage);
+    world.registerComponent<bench_component<1>>(Storage);
+    populate<2>(world, count);
+    for (auto _ : state) {
+        world.join<bench_component<0>, bench_component<1>>(
+            [](const vazel::ecs::Entity &, bench_component<0> &a,
+               bench_component<1> &b) { a.value[0] += b.value[0]; });
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_JoinCommon, vazel::ecs::ComponentStorage::Dense)
+    ->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_JoinCommon, vazel::ecs::ComponentStorage::Sparse)
+    ->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_JoinCommon, vazel::ecs::ComponentStorage::Paged)
+    ->VAZEL_BENCH_ENTITIES;
@@ -0,0 +1,54 @@
+/**
+ * bench/bench_Entity.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench_components.hpp"
+
+#include <benchmark/benchmark.h>
+
+static void BM_CreateEntity(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i != count; i++) {
+            benchmark::DoNotOptimize(world.createEntity());
+        }
+        state.PauseTiming();
+        world.clearWorld();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_CreateEntity)->VAZEL_BENCH_ENTITIES;
+
+static void BM_RemoveEntity(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<vazel::ecs::Entity> entities = populate<0>(world, count);
+        state.ResumeTiming();
+        for (auto &e : entities) {
+            world.removeEntity(e);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RemoveEntity)->VAZEL_BENCH_ENTITIES;
@@ -0,0 +1,172 @@
+/**
+ * bench/bench_System.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "bench_components.hpp"
+
+#include <benchmark/benchmark.h>
+
+/**
+ * @brief Fill an EntityManager with count entities, having the components 0
+ * to Components - 1 in their signature
+ *
+ */
+template <size_t Components>
+static void populateSignatures(vazel::ecs::EntityManager &em, size_t count)
+{
+    vazel::ecs::ComponentSignature signature;
+
+    for (size_t c = 0; c != Components; c++) {
+        signature.set(c, true);
+    }
+    for (size_t i = 0; i != count; i++) {
+        em.setSignature(em.createEntity(), signature);
+    }
+}
+
+template <size_t Components>
+static vazel::ecs::System makeSystem(void)
+{
+    vazel::ecs::System system("bench");
+
+    for (size_t c = 0; c != Components; c++) {
+        system.addDependency(c);
+    }
+    return system;
+}
+
+template <size_t Components>
+static void BM_UpdateValidEntities(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::EntityManager em;
+    vazel::ecs::System system = makeSystem<Components>();
+
+    populateSignatures<Components>(em, count);
+    system.updateValidEntities(em);
+    // Steady state: every entity is already known by the system
+    for (auto _ : state) {
+        system.updateValidEntities(em);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_UpdateValidEntities, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_UpdateValidEntities, 4)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_UpdateValidEntities, 8)->VAZEL_BENCH_ENTITIES;
+
+template <size_t Components>
+static void BM_UpdateValidEntitiesCold(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::EntityManager em;
+
+    populateSignatures<Components>(em, count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        vazel::ecs::System system = makeSystem<Components>();
+        state.ResumeTiming();
+        system.updateValidEntities(em);
+        state.PauseTiming();
+        // Destroying the entities set is not part of the measure
+        {
+            vazel::ecs::System discard = std::move(system);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_UpdateValidEntitiesCold, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_UpdateValidEntitiesCold, 8)->VAZEL_BENCH_ENTITIES;
+
+template <size_t Components>
+static void BM_SystemUpdate(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::World world;
+    vazel::ecs::System system("bench");
+
+    registerBenchComponents(world, std::make_index_sequence<Components>());
+    populate<Components>(world, count);
+    addBenchDependencies(world, system,
+                         std::make_index_sequence<Components>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        cm.getComponent<bench_component<0>>(e).value[0] += 1;
+    });
+    // Registered last so populating does not update the system each time
+    world.registerSystem(system);
+    for (auto _ : state) {
+        world.updateSystem();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_SystemUpdate, 1)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_SystemUpdate, 4)->VAZEL_BENCH_ENTITIES;
+BENCHMARK_TEMPLATE(BM_SystemUpdate, 8)->VAZEL_BENCH_ENTITIES;
+
+/**
+ * @brief Every entity has the component 0, one in a thousand the component 1
+ *
+ */
+static vazel::ecs::ComponentSignature populateSparse(
+    vazel::ecs::EntityManager &em, size_t count)
+{
+    vazel::ecs::ComponentSignature common;
+    vazel::ecs::ComponentSignature rare;
+
+    common.set(0, true);
+    rare.set(0, true);
+    rare.set(1, true);
+    for (size_t i = 0; i != count; i++) {
+        em.setSignature(em.createEntity(), i % 1000 == 0 ? rare : common);
+    }
+    return rare;
+}
+
+static void BM_JoinSparse(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::EntityManager em;
+    const vazel::ecs::ComponentSignature signature = populateSparse(em, count);
+
+    for (auto _ : state) {
+        size_t found = 0;
+
+        em.join(signature, [&found](const vazel::ecs::Entity &) { found++; });
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_JoinSparse)->VAZEL_BENCH_ENTITIES;
+
+static void BM_ScanSparse(benchmark::State &state)
+{
+    const size_t count = state.range(0);
+    vazel::ecs::EntityManager em;
+    const vazel::ecs::ComponentSignature signature = populateSparse(em, count);
+
+    // The signature test of every entity that join replaces
+    for (auto _ : state) {
+        size_t found = 0;
+
+        for (const auto &it : em.getMap()) {
+            found += vazel::ecs::isValidSignature(it.second.signature,
+                                                  signature);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ScanSparse)->VAZEL_BENCH_ENTITIES;
@@ -0,0 +1,92 @@
+/**
+ * bench/bench_components.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs.hpp"
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The entity counts every benchmark runs with
+ *
+ */
+#define VAZEL_BENCH_ENTITIES                                                 \
+    Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)
+
+template <size_t I>
+struct bench_component
+{
+    float value[4] = { 1, 1, 1, 1 };
+};
+
+template <size_t... I>
+static void registerBenchComponents(vazel::ecs::World &world,
+                                    std::index_sequence<I...>)
+{
+    (world.registerComponent<bench_component<I>>(), ...);
+}
+
+template <size_t... I>
+static void attachBenchComponents(vazel::ecs::World &world,
+                                  vazel::ecs::Entity &e,
+                                  std::index_sequence<I...>)
+{
+    (world.attachComponent<bench_component<I>>(e), ...);
+}
+
+template <size_t... I>
+static void detachBenchComponents(vazel::ecs::World &world,
+                                  vazel::ecs::Entity &e,
+                                  std::index_sequence<I...>)
+{
+    (world.detachComponent<bench_component<I>>(e), ...);
+}
+
+template <size_t... I>
+static void addBenchDependencies(vazel::ecs::World &world,
+                                 vazel::ecs::System &system,
+                                 std::index_sequence<I...>)
+{
+    (system.addDependency(
+         world.getComponentType<bench_component<I>>()),
+     ...);
+}
+
+/**
+ * @brief Create entities with the components 0 to Components - 1
+ *
+ * @tparam Components The number of components of every entity
+ * @param world The world to fill (its components must be registered)
+ * @param count The number of entities
+ * @return std::vector<vazel::ecs::Entity> The entities
+ */
+template <size_t Components>
+static std::vector<vazel::ecs::Entity> populate(vazel::ecs::World &world,
+                                                size_t count)
+{
+    std::vector<vazel::ecs::Entity> entities;
+
+    entities.reserve(count);
+    for (size_t i = 0; i != count; i++) {
+        entities.push_back(world.createEntity());
+        attachBenchComponents(world, entities.back(),
+                              std::make_index_sequence<Components>());
+    }
+    return entities;
+}
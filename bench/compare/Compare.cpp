@@ -0,0 +1,199 @@
+/**
+ * bench/compare/Compare.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Compare.hpp"
+
+#include <fstream>
+#include <sstream>
+
+static double unitToNanoseconds(const JsonValue *unit)
+{
+    if (unit == nullptr || unit->string == "ns") {
+        return 1;
+    }
+    if (unit->string == "us") {
+        return 1e3;
+    }
+    if (unit->string == "ms") {
+        return 1e6;
+    }
+    if (unit->string == "s") {
+        return 1e9;
+    }
+    throw JsonException("Unknown time unit \"" + unit->string + "\"");
+}
+
+BenchResults parseResults(std::istream &in, const std::string &metric)
+{
+    BenchResults results;
+    const JsonValue document    = parseJson(in);
+    const JsonValue *benchmarks = document.get("benchmarks");
+
+    if (benchmarks == nullptr ||
+        benchmarks->type != JsonValue::Type::Array) {
+        throw JsonException("No \"benchmarks\" array");
+    }
+    for (const auto &it : benchmarks->array) {
+        const JsonValue *name      = it.get("run_name");
+        const JsonValue *type      = it.get("run_type");
+        const JsonValue *aggregate = it.get("aggregate_name");
+        const JsonValue *error     = it.get("error_occurred");
+        const JsonValue *time      = it.get(metric);
+
+        if (name == nullptr) {
+            name = it.get("name");
+        }
+        if (time == nullptr) {
+            // The scenarios only measure the wall time
+            time = it.get("real_time");
+        }
+        if (name == nullptr || time == nullptr ||
+            (error != nullptr && error->boolean)) {
+            continue;
+        }
+        const double ns =
+            time->number * unitToNanoseconds(it.get("time_unit"));
+        BenchResult &res = results[name->string];
+
+        if (type != nullptr && type->string == "aggregate") {
+            if (aggregate != nullptr && aggregate->string == "median") {
+                res.sum    = ns;
+                res.runs   = 1;
+                res.median = true;
+            }
+        } else if (res.median == false) {
+            res.sum += ns;
+            res.runs++;
+        }
+    }
+    return results;
+}
+
+BenchResults loadResults(const std::string &path, const std::string &metric)
+{
+    std::ifstream file(path);
+
+    if (!file) {
+        throw JsonException("Cannot open " + path);
+    }
+    try {
+        return parseResults(file, metric);
+    } catch (const JsonException &e) {
+        throw JsonException(path + ": " + e.what());
+    }
+}
+
+std::vector<Threshold> parseThresholds(std::istream &in,
+                                       const std::string &path)
+{
+    std::vector<Threshold> thresholds;
+    std::string line;
+
+    for (size_t n = 1; std::getline(in, line); n++) {
+        std::istringstream words(line.substr(0, line.find('#')));
+        Threshold threshold;
+
+        if (!(words >> threshold.prefix)) {
+            continue;
+        }
+        if (!(words >> threshold.percent) || threshold.percent < 0) {
+            throw JsonException(path + ": line " + std::to_string(n) +
+                                ": Expected \"<name prefix> <percent>\"");
+        }
+        thresholds.push_back(threshold);
+    }
+    return thresholds;
+}
+
+std::vector<Threshold> loadThresholds(const std::string &path)
+{
+    std::ifstream file(path);
+
+    if (!file) {
+        throw JsonException("Cannot open " + path);
+    }
+    return parseThresholds(file, path);
+}
+
+double thresholdOf(const std::string &name,
+                   const std::vector<Threshold> &thresholds, double fallback)
+{
+    size_t longest = 0;
+    double percent = fallback;
+
+    for (const auto &it : thresholds) {
+        if (name.compare(0, it.prefix.size(), it.prefix) == 0 &&
+            it.prefix.size() >= longest) {
+            longest = it.prefix.size();
+            percent = it.percent;
+        }
+    }
+    return percent;
+}
+
+std::vector<BenchComparison> compareResults(
+    const BenchResults &baseline, const BenchResults &current,
+    const std::vector<Threshold> &thresholds, double fallback)
+{
+    std::vector<BenchComparison> comparison;
+
+    for (const auto &it : baseline) {
+        const auto found = current.find(it.first);
+        BenchComparison row;
+
+        row.name   = it.first;
+        row.before = it.second.time();
+        if (found == current.end()) {
+            row.status = BenchStatus::Missing;
+            comparison.push_back(row);
+            continue;
+        }
+        row.after = found->second.time();
+        row.delta =
+            row.before > 0 ? (row.after - row.before) / row.before * 100 : 0;
+        row.limit = thresholdOf(it.first, thresholds, fallback);
+        if (row.delta > row.limit) {
+            row.status = BenchStatus::Regression;
+        } else if (row.delta < -row.limit) {
+            row.status = BenchStatus::Improved;
+        }
+        comparison.push_back(row);
+    }
+    for (const auto &it : current) {
+        if (baseline.count(it.first) == 0) {
+            BenchComparison row;
+
+            row.name   = it.first;
+            row.after  = it.second.time();
+            row.status = BenchStatus::New;
+            comparison.push_back(row);
+        }
+    }
+    return comparison;
+}
+
+bool passesGate(const std::vector<BenchComparison> &comparison,
+                bool allowMissing)
+{
+    for (const auto &it : comparison) {
+        if (it.status == BenchStatus::Regression ||
+            (it.status == BenchStatus::Missing && allowMissing == false)) {
+            return false;
+        }
+    }
+    return true;
+}
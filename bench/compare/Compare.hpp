@@ -0,0 +1,154 @@
+/**
+ * bench/compare/Compare.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Json.hpp"
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The result of a benchmark, in nanoseconds. Repetitions are averaged
+ * unless a median aggregate is present.
+ *
+ */
+struct BenchResult
+{
+    double sum  = 0;
+    size_t runs = 0;
+    bool median = false;
+
+    double time(void) const
+    {
+        return runs ? sum / runs : 0;
+    }
+};
+
+using BenchResults = std::map<std::string, BenchResult>;
+
+/**
+ * @brief A noise threshold for the benchmarks whose name starts with prefix
+ *
+ */
+struct Threshold
+{
+    std::string prefix;
+    double percent;
+};
+
+/**
+ * @brief How a benchmark compares to its baseline
+ *
+ */
+enum class BenchStatus
+{
+    Same,
+    Regression,
+    Improved,
+    Missing,
+    New
+};
+
+/**
+ * @brief A row of the comparison, before and after are in nanoseconds and
+ * delta and limit in percent (0 for the missing and new benchmarks)
+ *
+ */
+struct BenchComparison
+{
+    std::string name;
+    double before      = 0;
+    double after       = 0;
+    double delta       = 0;
+    double limit       = 0;
+    BenchStatus status = BenchStatus::Same;
+};
+
+/**
+ * @brief Read the results of a Google Benchmark (or vazel_scenarios) JSON
+ * document
+ *
+ * @param in The document
+ * @param metric The time to compare, real_time or cpu_time
+ * @return BenchResults The results by benchmark name
+ * @throw JsonException The document is malformed or has no benchmarks
+ */
+BenchResults parseResults(std::istream &in, const std::string &metric);
+
+/**
+ * @brief Read the results of a JSON file (see parseResults)
+ *
+ */
+BenchResults loadResults(const std::string &path, const std::string &metric);
+
+/**
+ * @brief Read thresholds, one "<name prefix> <percent>" per line, '#'
+ * starts a comment
+ *
+ * @param in The text of the thresholds
+ * @param path The name of the text in the error messages
+ * @return std::vector<Threshold> The thresholds
+ * @throw JsonException A line is malformed
+ */
+std::vector<Threshold> parseThresholds(std::istream &in,
+                                       const std::string &path);
+
+/**
+ * @brief Read the thresholds of a file (see parseThresholds)
+ *
+ */
+std::vector<Threshold> loadThresholds(const std::string &path);
+
+/**
+ * @brief Get the threshold of a benchmark, the longest matching prefix wins
+ *
+ * @param name The benchmark name
+ * @param thresholds The thresholds
+ * @param fallback The threshold when no prefix matches
+ * @return double The threshold in percent
+ */
+double thresholdOf(const std::string &name,
+                   const std::vector<Threshold> &thresholds, double fallback);
+
+/**
+ * @brief Compare new results to a baseline
+ *
+ * @param baseline The baseline results
+ * @param current The new results
+ * @param thresholds The thresholds by name prefix
+ * @param fallback The threshold when no prefix matches
+ * @return std::vector<BenchComparison> The baseline benchmarks by name,
+ * then the new ones
+ */
+std::vector<BenchComparison> compareResults(
+    const BenchResults &baseline, const BenchResults &current,
+    const std::vector<Threshold> &thresholds, double fallback);
+
+/**
+ * @brief Decide if a comparison passes the gate: no regression and, unless
+ * allowed, no baseline benchmark missing from the new results (it crashed,
+ * was renamed or filtered out)
+ *
+ * @param comparison The comparison
+ * @param allowMissing True to accept missing benchmarks
+ * @return bool True if it passes
+ */
+bool passesGate(const std::vector<BenchComparison> &comparison,
+                bool allowMissing);
@@ -0,0 +1,206 @@
+/**
+ * bench/compare/Json.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+JsonException::JsonException(const std::string &e)
+{
+    _e += e;
+}
+
+const char *JsonException::what() const throw()
+{
+    return _e.c_str();
+}
+
+const JsonValue *JsonValue::get(const std::string &key) const
+{
+    for (const auto &it : object) {
+        if (it.first == key) {
+            return &it.second;
+        }
+    }
+    return nullptr;
+}
+
+namespace
+{
+    class JsonParser
+    {
+      private:
+        const std::string &_text;
+        size_t _pos = 0;
+
+        [[noreturn]] void __fail(const std::string &what) const
+        {
+            throw JsonException(what + " at offset " + std::to_string(_pos));
+        }
+
+        void __skipSpaces(void)
+        {
+            while (_pos < _text.size() &&
+                   (_text[_pos] == ' ' || _text[_pos] == '\t' ||
+                    _text[_pos] == '\n' || _text[_pos] == '\r')) {
+                _pos++;
+            }
+        }
+
+        char __peek(void)
+        {
+            __skipSpaces();
+            if (_pos >= _text.size()) {
+                __fail("Unexpected end");
+            }
+            return _text[_pos];
+        }
+
+        void __expect(char c)
+        {
+            if (__peek() != c) {
+                __fail(std::string("Expected '") + c + "'");
+            }
+            _pos++;
+        }
+
+        void __literal(const char *word)
+        {
+            for (; *word != '\0'; word++, _pos++) {
+                if (_pos >= _text.size() || _text[_pos] != *word) {
+                    __fail("Invalid literal");
+                }
+            }
+        }
+
+        std::string __string(void)
+        {
+            std::string str;
+
+            __expect('"');
+            while (_pos < _text.size() && _text[_pos] != '"') {
+                char c = _text[_pos++];
+
+                if (c == '\\' && _pos < _text.size()) {
+                    // Pairs of escape letter and escaped character
+                    static const char escapes[] = "n\nt\tr\rb\bf\f";
+                    const char *escape          = nullptr;
+
+                    c = _text[_pos++];
+                    if (c == 'u') {
+                        // Benchmark names are ASCII, keep the low byte
+                        if (_pos + 4 > _text.size()) {
+                            __fail("Invalid escape");
+                        }
+                        c = static_cast<char>(std::strtol(
+                            _text.substr(_pos, 4).c_str(), nullptr, 16));
+                        _pos += 4;
+                    } else if ((escape = strchr(escapes, c)) != nullptr &&
+                               (escape - escapes) % 2 == 0) {
+                        c = escape[1];
+                    }
+                }
+                str += c;
+            }
+            if (_pos >= _text.size()) {
+                __fail("Unterminated string");
+            }
+            _pos++;
+            return str;
+        }
+
+      public:
+        JsonParser(const std::string &text)
+            : _text(text)
+        {
+        }
+
+        JsonValue value(void)
+        {
+            JsonValue v;
+            const char c = __peek();
+
+            if (c == '{') {
+                v.type = JsonValue::Type::Object;
+                _pos++;
+                if (__peek() == '}') {
+                    _pos++;
+                    return v;
+                }
+                do {
+                    std::string key = __string();
+
+                    __expect(':');
+                    v.object.emplace_back(std::move(key), value());
+                } while (__peek() == ',' && ++_pos);
+                __expect('}');
+            } else if (c == '[') {
+                v.type = JsonValue::Type::Array;
+                _pos++;
+                if (__peek() == ']') {
+                    _pos++;
+                    return v;
+                }
+                do {
+                    v.array.push_back(value());
+                } while (__peek() == ',' && ++_pos);
+                __expect(']');
+            } else if (c == '"') {
+                v.type   = JsonValue::Type::String;
+                v.string = __string();
+            } else if (c == 't' || c == 'f') {
+                v.type    = JsonValue::Type::Bool;
+                v.boolean = c == 't';
+                __literal(v.boolean ? "true" : "false");
+            } else if (c == 'n') {
+                __literal("null");
+            } else {
+                const char *begin = _text.c_str() + _pos;
+                char *end         = nullptr;
+
+                v.type   = JsonValue::Type::Number;
+                v.number = std::strtod(begin, &end);
+                if (end == begin) {
+                    __fail("Unexpected character");
+                }
+                _pos += end - begin;
+            }
+            return v;
+        }
+
+        void finish(void)
+        {
+            __skipSpaces();
+            if (_pos != _text.size()) {
+                __fail("Trailing characters");
+            }
+        }
+    };
+} // namespace
+
+JsonValue parseJson(std::istream &in)
+{
+    const std::string text((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+    JsonParser parser(text);
+    JsonValue document = parser.value();
+
+    parser.finish();
+    return document;
+}
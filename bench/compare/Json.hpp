@@ -0,0 +1,81 @@
+/**
+ * bench/compare/Json.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief JsonException is thrown on malformed JSON
+ *
+ */
+class JsonException : public vazel::VException
+{
+  private:
+    std::string _e = "JsonException: ";
+
+  public:
+    JsonException(const std::string &e);
+    const char *what() const throw() override;
+};
+
+/**
+ * @brief A parsed JSON value, just enough to read benchmark results
+ *
+ */
+struct JsonValue
+{
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type type     = Type::Null;
+    bool boolean  = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    /**
+     * @brief Get a member of an object
+     *
+     * @param key The key of the member
+     * @return const JsonValue* The member (nullptr if it is not an object or
+     * has no such member)
+     */
+    const JsonValue *get(const std::string &key) const;
+};
+
+/**
+ * @brief Parse a JSON document
+ *
+ * @param in The stream to read
+ * @return JsonValue The document
+ * @throw JsonException The document is malformed
+ */
+JsonValue parseJson(std::istream &in);
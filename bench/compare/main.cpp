@@ -0,0 +1,141 @@
+/**
+ * bench/compare/main.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Compare.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--threshold PERCENT] [--thresholds FILE] "
+            "[--metric real_time|cpu_time]\n       [--allow-missing] "
+            "<baseline.json> <new.json>\n"
+            "Compare two Google Benchmark (or vazel_scenarios) JSON results "
+            "and exit with 1\nif a benchmark is slower than its threshold "
+            "or, unless --allow-missing is\ngiven, if a baseline benchmark "
+            "is missing from the new results.\n"
+            "A thresholds file has one \"<name prefix> <percent>\" per line, "
+            "the longest\nmatching prefix wins.\n",
+            name);
+    return 2;
+}
+
+static std::string formatTime(double ns)
+{
+    static const char *units[] = { "ns", "us", "ms", "s" };
+    size_t unit                = 0;
+    char buf[32];
+
+    while (ns >= 1000 && unit != 3) {
+        ns /= 1000;
+        unit++;
+    }
+    snprintf(buf, sizeof(buf), "%.3f %s", ns, units[unit]);
+    return buf;
+}
+
+int main(int ac, char **av)
+{
+    double fallback    = 5;
+    std::string metric = "real_time";
+    bool allowMissing  = false;
+    std::vector<Threshold> thresholds;
+    std::vector<std::string> paths;
+
+    try {
+        for (int i = 1; i < ac; i++) {
+            if (strcmp(av[i], "--threshold") == 0 && i + 1 < ac) {
+                fallback = std::stod(av[++i]);
+            } else if (strcmp(av[i], "--thresholds") == 0 && i + 1 < ac) {
+                thresholds = loadThresholds(av[++i]);
+            } else if (strcmp(av[i], "--metric") == 0 && i + 1 < ac) {
+                metric = av[++i];
+            } else if (strcmp(av[i], "--allow-missing") == 0) {
+                allowMissing = true;
+            } else if (av[i][0] == '-') {
+                return usage(av[0]);
+            } else {
+                paths.push_back(av[i]);
+            }
+        }
+    } catch (const JsonException &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 2;
+    } catch (const std::exception &) {
+        return usage(av[0]);
+    }
+    if (paths.size() != 2) {
+        return usage(av[0]);
+    }
+
+    BenchResults baseline;
+    BenchResults current;
+    try {
+        baseline = loadResults(paths[0], metric);
+        current  = loadResults(paths[1], metric);
+    } catch (const JsonException &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    const std::vector<BenchComparison> comparison =
+        compareResults(baseline, current, thresholds, fallback);
+    size_t regressions  = 0;
+    size_t improvements = 0;
+    size_t missing      = 0;
+
+    printf("%-44s %12s %12s %9s %7s\n", "benchmark", "baseline", "new",
+           "delta", "limit");
+    for (const auto &it : comparison) {
+        const char *name = it.name.c_str();
+
+        switch (it.status) {
+        case BenchStatus::Missing:
+            printf("%-44s %12s %12s %9s %7s  MISSING\n", name,
+                   formatTime(it.before).c_str(), "-", "-", "-");
+            missing++;
+            continue;
+        case BenchStatus::New:
+            printf("%-44s %12s %12s %9s %7s  new\n", name, "-",
+                   formatTime(it.after).c_str(), "-", "-");
+            continue;
+        case BenchStatus::Regression:
+            regressions++;
+            break;
+        case BenchStatus::Improved:
+            improvements++;
+            break;
+        case BenchStatus::Same:
+            break;
+        }
+        printf("%-44s %12s %12s %+8.1f%% %6.1f%%%s\n", name,
+               formatTime(it.before).c_str(), formatTime(it.after).c_str(),
+               it.delta, it.limit,
+               it.status == BenchStatus::Regression ? "  REGRESSION"
+               : it.status == BenchStatus::Improved ? "  improved"
+                                                    : "");
+    }
+    printf("\n%zu regression(s), %zu improvement(s), %zu missing over %zu "
+           "benchmark(s)%s\n",
+           regressions, improvements, missing, baseline.size(),
+           missing != 0 && allowMissing ? " (missing allowed)" : "");
+    return passesGate(comparison, allowMissing) ? 0 : 1;
+}
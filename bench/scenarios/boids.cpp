@@ -0,0 +1,106 @@
+/**
+ * bench/scenarios/boids.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scenarios.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Distance under which the boids see each other
+static const float s_radius = 4;
+
+void buildBoids(vazel::ecs::World &world, vazel::sim::Runner &,
+                size_t entities)
+{
+    const float size = std::sqrt(static_cast<float>(entities)) * s_radius;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> place(0, size);
+    std::uniform_real_distribution<float> speed(-1, 1);
+    vazel::ecs::System flock("flock");
+    vazel::ecs::System integrate("integrate");
+
+    world.registerComponent<Velocity>();
+    world.enableSpatialIndex<Position>(s_radius);
+    for (size_t i = 0; i != entities; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+        Position position    = { place(rng), place(rng) };
+        Velocity velocity    = { speed(rng), speed(rng) };
+
+        world.attachComponent<Position>(e, position);
+        world.attachComponent<Velocity>(e, velocity);
+    }
+
+    flock.addDependency(world.getComponentType<Position>());
+    flock.addDependency(world.getComponentType<Velocity>());
+    integrate.addDependency(world.getComponentType<Position>());
+    integrate.addDependency(world.getComponentType<Velocity>());
+
+    auto neighbours = std::make_shared<std::vector<vazel::ecs::Entity>>();
+    vazel::ecs::World *w = &world;
+
+    flock.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, w, neighbours) {
+        const Position &self = cm.getComponent<Position>(e);
+        Velocity &velocity   = cm.getComponent<Velocity>(e);
+        Velocity align       = { 0, 0 };
+        Position center      = { 0, 0 };
+        Velocity away        = { 0, 0 };
+        size_t count         = 0;
+
+        neighbours->clear();
+        w->getSpatialIndex().queryRadius({ self.x, self.y }, s_radius,
+                                         *neighbours);
+        for (const auto &n : *neighbours) {
+            if (n == e) {
+                continue;
+            }
+            const Position &p = cm.getComponent<Position>(n);
+            const Velocity &v = cm.getComponent<Velocity>(n);
+            const float dx    = self.x - p.x;
+            const float dy    = self.y - p.y;
+            const float d2    = dx * dx + dy * dy + 0.01f;
+
+            align.x += v.x;
+            align.y += v.y;
+            center.x += p.x;
+            center.y += p.y;
+            away.x += dx / d2;
+            away.y += dy / d2;
+            count++;
+        }
+        if (count == 0) {
+            return;
+        }
+        velocity.x += (align.x / count - velocity.x) * 0.05f +
+                      (center.x / count - self.x) * 0.01f + away.x * 0.1f;
+        velocity.y += (align.y / count - velocity.y) * 0.05f +
+                      (center.y / count - self.y) * 0.01f + away.y * 0.1f;
+    });
+    integrate.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, size) {
+        Position &position       = cm.getComponent<Position>(e);
+        const Velocity &velocity = cm.getComponent<Velocity>(e);
+
+        position.x = std::fmod(position.x + velocity.x * VAZEL_SCENARIO_DT +
+                                   size,
+                               size);
+        position.y = std::fmod(position.y + velocity.y * VAZEL_SCENARIO_DT +
+                                   size,
+                               size);
+    });
+    world.registerSystem(flock);
+    world.registerSystem(integrate);
+}
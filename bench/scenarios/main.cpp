@@ -0,0 +1,185 @@
+/**
+ * bench/scenarios/main.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scenarios.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+struct MacroScenario
+{
+    const char *name;
+    size_t entities;
+    void (*build)(vazel::ecs::World &, vazel::sim::Runner &, size_t);
+};
+
+static const MacroScenario s_scenarios[] = {
+    { "boids", 2000, buildBoids },
+    { "particles", 2000, buildParticles },
+    { "pipeline", 10000, buildPipeline },
+};
+
+static int usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--ticks N] [--out results.json] [--perf] "
+            "[scenario...]\n"
+            "scenarios:",
+            name);
+    for (const auto &it : s_scenarios) {
+        fprintf(stderr, " %s", it.name);
+    }
+    fprintf(stderr, "\n");
+    return 2;
+}
+
+/**
+ * @brief Write a scenario in the format of the Google Benchmark JSON output
+ * (real_time is the mean duration of a tick) so both can be compared by the
+ * same tools
+ *
+ */
+static void writeResult(FILE *out, const MacroScenario &scenario,
+                        const vazel::sim::SimulationReport &report,
+                        bool first)
+{
+    const double mean =
+        report.ticks ? static_cast<double>(report.elapsed.count()) /
+                           report.ticks
+                     : 0;
+
+    fprintf(out, "%s    {\n", first ? "" : ",\n");
+    fprintf(out, "      \"name\": \"%s\",\n", scenario.name);
+    fprintf(out, "      \"run_type\": \"iteration\",\n");
+    fprintf(out, "      \"iterations\": %lu,\n", report.ticks);
+    fprintf(out, "      \"real_time\": %.1f,\n", mean);
+    fprintf(out, "      \"time_unit\": \"ns\",\n");
+    fprintf(out, "      \"entities\": %zu,\n", scenario.entities);
+    fprintf(out, "      \"ticks_per_second\": %.2f,\n",
+            report.ticksPerSecond());
+    fprintf(out, "      \"frame_min\": %ld,\n",
+            report.framePercentile(0).count());
+    for (const int p : { 50, 90, 99 }) {
+        fprintf(out, "      \"frame_p%d\": %ld,\n", p,
+                report.framePercentile(p).count());
+    }
+    fprintf(out, "      \"frame_max\": %ld,\n",
+            report.framePercentile(100).count());
+    fprintf(out, "      \"peak_memory\": %zu,\n", report.peakMemory);
+    if (vazel::profiling::allocTrackingEnabled()) {
+        fprintf(out, "      \"allocations_per_tick\": %.2f,\n",
+                report.ticks ? double(report.allocations.allocations) /
+                                   report.ticks
+                             : 0);
+        fprintf(out, "      \"allocated_bytes_per_tick\": %.1f,\n",
+                report.ticks ? double(report.allocations.bytes) / report.ticks
+                             : 0);
+    }
+    fprintf(out, "      \"systems\": [");
+    for (size_t i = 0; i != report.systems.size(); i++) {
+        const vazel::sim::SystemReport &system = report.systems[i];
+
+        fprintf(out,
+                "%s\n        { \"tag\": \"%s\", \"total_ns\": %ld, "
+                "\"max_ns\": %ld",
+                i ? "," : "", system.tag.c_str(), system.total.count(),
+                system.max.count());
+        if (report.hasPerfCounters) {
+            fprintf(out,
+                    ", \"cycles\": %lu, \"instructions\": %lu, "
+                    "\"cache_misses\": %lu, \"branch_misses\": %lu",
+                    system.counters.cycles, system.counters.instructions,
+                    system.counters.cacheMisses,
+                    system.counters.branchMisses);
+        }
+        fprintf(out, " }");
+    }
+    fprintf(out, "\n      ]\n    }");
+}
+
+int main(int ac, char **av)
+{
+    uint64_t ticks   = 300;
+    const char *path = nullptr;
+    bool perf        = false;
+    std::vector<const MacroScenario *> selected;
+
+    try {
+        for (int i = 1; i < ac; i++) {
+            if (strcmp(av[i], "--ticks") == 0 && i + 1 < ac) {
+                ticks = std::stoull(av[++i]);
+            } else if (strcmp(av[i], "--out") == 0 && i + 1 < ac) {
+                path = av[++i];
+            } else if (strcmp(av[i], "--perf") == 0) {
+                perf = true;
+            } else {
+                const MacroScenario *found = nullptr;
+
+                for (const auto &it : s_scenarios) {
+                    if (strcmp(it.name, av[i]) == 0) {
+                        found = &it;
+                    }
+                }
+                if (found == nullptr) {
+                    return usage(av[0]);
+                }
+                selected.push_back(found);
+            }
+        }
+    } catch (const std::exception &) {
+        return usage(av[0]);
+    }
+    if (selected.empty()) {
+        for (const auto &it : s_scenarios) {
+            selected.push_back(&it);
+        }
+    }
+
+    FILE *out = path != nullptr ? fopen(path, "w") : stdout;
+    if (out == nullptr) {
+        perror(path);
+        return 1;
+    }
+    fprintf(out, "{\n  \"context\": { \"ticks\": %lu },\n", ticks);
+    fprintf(out, "  \"benchmarks\": [\n");
+    try {
+        for (size_t i = 0; i != selected.size(); i++) {
+            vazel::ecs::World world;
+            vazel::sim::Runner runner(world);
+
+            runner.enablePerfCounters(perf);
+            selected[i]->build(world, runner, selected[i]->entities);
+            const vazel::sim::SimulationReport report = runner.run(ticks);
+
+            writeResult(out, *selected[i], report, i == 0);
+            fprintf(stderr, "%-12s %10.1f ticks/s  p99 %.3f ms\n",
+                    selected[i]->name, report.ticksPerSecond(),
+                    report.framePercentile(99).count() / 1e6);
+        }
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * bench/scenarios/particles.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scenarios.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+struct Lifetime
+{
+    float remaining;
+};
+
+// Average lifetime of a particle in seconds
+static const float s_lifetime = 1.25f;
+
+static void spawn(vazel::ecs::World &world, std::mt19937 &rng, size_t count)
+{
+    std::uniform_real_distribution<float> speed(-5, 5);
+    std::uniform_real_distribution<float> life(0.5f, 2 * s_lifetime - 0.5f);
+
+    for (size_t i = 0; i != count; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+        Position position    = { 0, 0 };
+        Velocity velocity    = { speed(rng), speed(rng) + 10 };
+        Lifetime lifetime    = { life(rng) };
+
+        world.attachComponent<Position>(e, position);
+        world.attachComponent<Velocity>(e, velocity);
+        world.attachComponent<Lifetime>(e, lifetime);
+    }
+}
+
+void buildParticles(vazel::ecs::World &world, vazel::sim::Runner &runner,
+                    size_t entities)
+{
+    const size_t perTick = std::max<size_t>(
+        1, entities / static_cast<size_t>(s_lifetime / VAZEL_SCENARIO_DT));
+    auto rng  = std::make_shared<std::mt19937>(42);
+    auto dead = std::make_shared<std::vector<vazel::ecs::Entity>>();
+    vazel::ecs::System gravity("gravity");
+    vazel::ecs::System integrate("integrate");
+    vazel::ecs::System age("age");
+
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerComponent<Lifetime>();
+    gravity.addDependency(world.getComponentType<Velocity>());
+    integrate.addDependency(world.getComponentType<Position>());
+    integrate.addDependency(world.getComponentType<Velocity>());
+    age.addDependency(world.getComponentType<Lifetime>());
+
+    gravity.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        cm.getComponent<Velocity>(e).y -= 9.81f * VAZEL_SCENARIO_DT;
+    });
+    integrate.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        Position &position       = cm.getComponent<Position>(e);
+        const Velocity &velocity = cm.getComponent<Velocity>(e);
+
+        position.x += velocity.x * VAZEL_SCENARIO_DT;
+        position.y += velocity.y * VAZEL_SCENARIO_DT;
+    });
+    age.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, dead) {
+        Lifetime &lifetime = cm.getComponent<Lifetime>(e);
+
+        lifetime.remaining -= VAZEL_SCENARIO_DT;
+        if (lifetime.remaining <= 0) {
+            dead->push_back(e);
+        }
+    });
+    world.registerSystem(gravity);
+    world.registerSystem(integrate);
+    world.registerSystem(age);
+    spawn(world, *rng, entities);
+
+    // The systems cannot remove entities while the world updates them
+    runner.setOnTick([rng, dead, perTick](vazel::ecs::World &w) {
+        for (auto &e : *dead) {
+            w.removeEntity(e);
+        }
+        dead->clear();
+        spawn(w, *rng, perTick);
+    });
+}
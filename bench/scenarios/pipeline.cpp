@@ -0,0 +1,43 @@
+/**
+ * bench/scenarios/pipeline.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "scenarios.hpp"
+
+#include <cstdio>
+
+void buildPipeline(vazel::ecs::World &world, vazel::sim::Runner &,
+                   size_t entities)
+{
+    vazel::sim::Scenario scenario;
+
+    scenario.entities   = entities;
+    scenario.components = 8;
+    scenario.density    = { 1, 1, 1, 0.75, 0.5, 0.5, 0.25, 0.1 };
+    for (size_t i = 0; i != 50; i++) {
+        vazel::sim::ScenarioSystem system;
+        char tag[16];
+
+        snprintf(tag, sizeof(tag), "stage%02zu", i);
+        system.tag        = tag;
+        system.components = { i % 8, (i + 1) % 8 };
+        if (i % 3 == 0) {
+            system.components.push_back((i + 3) % 8);
+        }
+        scenario.systems.push_back(system);
+    }
+    vazel::sim::buildScenario(world, scenario);
+}
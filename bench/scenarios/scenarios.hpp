@@ -0,0 +1,69 @@
+/**
+ * bench/scenarios/scenarios.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs.hpp"
+#include "Vazel/sim.hpp"
+
+/**
+ * @brief The simulated time of a tick in the scenarios
+ *
+ */
+#define VAZEL_SCENARIO_DT (1.0f / 60)
+
+struct Position
+{
+    float x, y;
+};
+
+struct Velocity
+{
+    float x, y;
+};
+
+/**
+ * @brief Boids flocking: alignment, cohesion and separation from the
+ * neighbours found through the spatial index, then integration and wrapping.
+ *
+ * @param world The empty world to fill
+ * @param runner The runner of the world
+ * @param entities The number of boids
+ */
+void buildBoids(vazel::ecs::World &world, vazel::sim::Runner &runner,
+                size_t entities);
+
+/**
+ * @brief A particle spawner: particles fall, age and die, and the dead are
+ * replaced every tick so the population stays around entities.
+ *
+ * @param world The empty world to fill
+ * @param runner The runner of the world
+ * @param entities The steady population
+ */
+void buildParticles(vazel::ecs::World &world, vazel::sim::Runner &runner,
+                    size_t entities);
+
+/**
+ * @brief A pipeline of 50 systems over 8 components of varying density
+ *
+ * @param world The empty world to fill
+ * @param runner The runner of the world
+ * @param entities The number of entities
+ */
+void buildPipeline(vazel::ecs::World &world, vazel::sim::Runner &runner,
+                   size_t entities);
@@ -0,0 +1,59 @@
+/**
+ * include/Vazel/ThreadSlot.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+
+#include <cstddef>
+
+/**
+ * @brief The maximum number of threads alive at the same time that can use
+ * per-thread storage (event channels, scratch allocators...)
+ *
+ */
+#define VAZEL_MAX_THREADS 64
+
+namespace vazel
+{
+
+    /**
+     * @brief ThreadSlotException is thrown when more than VAZEL_MAX_THREADS
+     * threads ask for a slot at the same time.
+     *
+     */
+    class ThreadSlotException : public VException
+    {
+      public:
+        const char *what() const throw() override
+        {
+            return "ThreadSlotException: Too many threads are using per-thread "
+                   "storage (see VAZEL_MAX_THREADS)";
+        }
+    };
+
+    /**
+     * @brief Get the slot of the calling thread, a small index in
+     * [0, VAZEL_MAX_THREADS) that no other living thread owns.
+     * The slot is given on the first call and released when the thread exits
+     * so it can be reused by a new thread.
+     *
+     * @return size_t The slot of the calling thread
+     */
+    size_t threadSlot(void);
+
+} // namespace vazel
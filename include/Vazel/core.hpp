@@ -19,4 +19,7 @@
 #pragma once
 
 #include "Vazel/core/App/App.hpp"
+#include "Vazel/core/FrameClock/FrameClock.hpp"
+#include "Vazel/core/FrameWatchdog/FrameWatchdog.hpp"
 #include "Vazel/core/State/State.hpp"
+#include "Vazel/core/WorldHost/WorldHost.hpp"
@@ -17,10 +17,15 @@
  */
 #pragma once
 
+#include "Vazel/core/Event/InputRecorder.hpp"
+#include "Vazel/core/FrameClock/FrameClock.hpp"
+#include "Vazel/core/FrameWatchdog/FrameWatchdog.hpp"
 #include "Vazel/core/State/State.hpp"
 #include "Vazel/core/_priv.hpp"
 #include "Vazel/ecs/World/World.hpp"
 
+#include <future>
+
 namespace vazel
 {
     namespace core
@@ -62,16 +67,97 @@ namespace vazel
         const std::vector<std::unique_ptr<State>>::iterator getStateFromTag(
             std::vector<std::unique_ptr<State>> &states, StateTag stateTag);
 
+        /**
+         * @brief A state suspended by App::pushState and the world it left
+         *
+         */
+        struct SuspendedState
+        {
+            State *state;
+            std::unique_ptr<ecs::World> world;
+        };
+
         class App
         {
           private:
+            /**
+             * @brief The transition applied at the next frame boundary
+             *
+             */
+            enum class Transition
+            {
+                None,
+                Set,
+                Push,
+                Pop,
+                Stop,
+                Swap
+            };
+
             std::vector<std::unique_ptr<State>> _states;
-            State *_current_state = nullptr;
-            State *_pending_state = nullptr;
+            std::vector<SuspendedState> _stack;
+            State *_current_state    = nullptr;
+            State *_pending_state    = nullptr;
+            Transition _transition   = Transition::None;
+            std::future<void> _loading;
+            std::unique_ptr<ecs::World> _staging;
+            State *_loading_state     = nullptr;
+            InputRecorder *_recorder  = nullptr;
+            InputReplay *_replay      = nullptr;
+            uint64_t _frame           = 0;
+            bool _background_teardown = false;
+            std::unique_ptr<ecs::WorldMetrics> _world_metrics;
+            profiling::Histogram *_frame_time = nullptr;
+            profiling::Gauge *_pending_events = nullptr;
             static App *instance;
 
+            /**
+             * @brief Apply the pending transition, or pop the current state
+             * if it stopped by itself
+             *
+             */
+            void __applyTransition(void);
+
+            /**
+             * @brief Ask for the swap to the loaded state once its background
+             * load is over (rethrows what the load threw)
+             *
+             */
+            void __pollLoading(void);
+
+            /**
+             * @brief Forget the state being loaded, its load keeps running in
+             * the background and is dropped once over
+             *
+             */
+            void __cancelLoading(void);
+
+            /**
+             * @brief Clear the world of the state that exits
+             *
+             */
+            void __clearWorld(void);
+
+            /**
+             * @brief Exit the current state then resume the last suspended
+             * state with its world
+             *
+             */
+            void __popState(void);
+
+            /**
+             * @brief Stamp the recorder and feed the replay for the frame
+             * about to be updated
+             *
+             * @return bool False if the replay is over and the app stopped
+             */
+            bool __beginFrame(void);
+
           public:
             ecs::World world;
+            FrameClock clock;
+            // Keeps the frames over budget, see FrameWatchdog::setBudget
+            FrameWatchdog watchdog;
 
           protected:
             /**
@@ -94,18 +180,73 @@ namespace vazel
             static App &getInstance(void);
 
             /**
-             * @brief Stop the current state.
+             * @brief Stop the current state and every suspended state, run
+             * returns at the end of the frame.
              *
              */
             void stop(void);
 
             /**
-             * @brief Set the current state.
+             * @brief Set the current state. The current state is exited and
+             * its world is cleared at the end of the frame, the suspended
+             * states are kept.
              *
              * @param stateTag The state tag.
              */
             void setState(StateTag stateTag);
 
+            /**
+             * @brief Suspend the current state and start a new one on top of
+             * it at the end of the frame. The world of the suspended state is
+             * kept aside (swapped in O(1)) and the new state starts with an
+             * empty world.
+             *
+             * @param stateTag The state tag.
+             */
+            void pushState(StateTag stateTag);
+
+            /**
+             * @brief Exit the current state at the end of the frame and resume
+             * the state it was pushed on, with the world it left. A state that
+             * stops by itself is popped the same way.
+             *
+             */
+            void popState(void);
+
+            /**
+             * @brief Set the current state once it is loaded. The load
+             * function of the state (see State::setOnLoad) builds a staging
+             * world on a background thread while the current state keeps
+             * updating. At the first frame boundary after the load, the
+             * current state is exited, the staging world is swapped in and the
+             * new state is initialized. Any other transition cancels the load.
+             *
+             * @param stateTag The state tag.
+             */
+            void setStateAsync(StateTag stateTag);
+
+            /**
+             * @brief Check if a state is loading in the background
+             *
+             * @return bool True if a state is loading
+             */
+            bool isLoading(void) const;
+
+            /**
+             * @brief Destroy the world of the exiting states on the
+             * WorldReaper thread instead of during the transition
+             *
+             * @param enabled True to tear down in the background
+             */
+            void setBackgroundTeardown(bool enabled);
+
+            /**
+             * @brief Get the number of states suspended under the current one
+             *
+             * @return size_t The number of suspended states
+             */
+            size_t getSuspendedCount(void) const;
+
             /**
              * @brief Register a new state.
              *
@@ -113,9 +254,55 @@ namespace vazel
              */
             void registerState(State &state);
 
+            /**
+             * @brief Get the number of frames updated since the app started
+             *
+             * @return uint64_t The current frame
+             */
+            uint64_t getFrame(void) const;
+
+            /**
+             * @brief Get the simulated time of the update in progress in
+             * seconds (also given to the world, see World::getDeltaTime)
+             *
+             * @return double The delta time
+             */
+            double getDeltaTime(void) const;
+
+            /**
+             * @brief Record every keyboard event consumed by the states with
+             * the frame during which it was consumed
+             *
+             * @param recorder The recorder (nullptr to stop recording)
+             */
+            void setInputRecorder(InputRecorder *recorder);
+
+            /**
+             * @brief Feed the events of a replay at the frame they were
+             * recorded, the app stops once the end of the recording is
+             * reached. Frames are not paced during a replay.
+             *
+             * @param replay The replay (nullptr to stop replaying)
+             */
+            void setInputReplay(InputReplay *replay);
+
+            /**
+             * @brief Publish the metrics of the app in a registry: the
+             * duration of the frames (vazel_frame_seconds), the keyboard
+             * events waiting at the beginning of a frame
+             * (vazel_keyboard_events_pending) and the counters of the world
+             * (see WorldMetrics, world="app"). Export them with a
+             * MetricsExporter.
+             *
+             * @param metrics The registry (nullptr to stop publishing)
+             */
+            void setMetrics(profiling::Metrics *metrics);
+
             /**
              * @brief Init the pending state and set it as the current state.
-             *        Then call the update state while it's running.
+             *        Then call the update state while it's running, as many
+             *        times per frame as the clock asks. The state transitions
+             *        are applied between two frames.
              */
             void run(void);
         };
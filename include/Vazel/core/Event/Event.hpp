@@ -16,14 +16,23 @@
 
 #pragma once
 
+#include "Vazel/core/Event/RingBuffer.hpp"
+
 #include <cinttypes>
-#include <mutex>
-#include <queue>
+#include <span>
+
+/**
+ * @brief The maximum number of keyboard events waiting to be polled.
+ *
+ */
+#define VAZEL_KEYBOARD_EVENT_CAPACITY 1024
 
 namespace vazel
 {
     namespace core
     {
+        class InputRecorder;
+
         class Keyboard
         {
           public:
@@ -142,12 +151,50 @@ namespace vazel
             };
 
           private:
-            static std::mutex _keyboardMut;
-            static std::queue<Input> _events;
+            static RingBuffer<Input, VAZEL_KEYBOARD_EVENT_CAPACITY> _events;
+            static InputRecorder *_recorder;
 
           public:
+            /**
+             * @brief Pop the oldest pending event (consumer thread only)
+             *
+             * @param type Set to the event
+             * @return bool False if there was no pending event
+             */
             static bool poll(Input& type);
-            static void pushEvent(const Input& type);
+
+            /**
+             * @brief Pop every pending event at once (consumer thread only)
+             *
+             * @param events Receives the events in the order they were pushed
+             * @return size_t The number of events written in events
+             */
+            static size_t drain(std::span<Input> events);
+
+            /**
+             * @brief Push an event, can be called from any thread without
+             * locking
+             *
+             * @param type The event
+             * @return bool False if the queue is full and the event was
+             * dropped
+             */
+            static bool pushEvent(const Input& type);
+
+            /**
+             * @brief Get the number of events waiting to be polled
+             *
+             * @return size_t The number of pending events
+             */
+            static size_t pending(void);
+
+            /**
+             * @brief Record every consumed event in recorder
+             *
+             * @param recorder The recorder (nullptr to stop recording)
+             */
+            static void setRecorder(InputRecorder *recorder);
+
             Keyboard()  = default;
             ~Keyboard() = default;
         };
@@ -0,0 +1,196 @@
+/**
+ * include/Vazel/core/Event/InputRecorder.hpp
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vazel/VException.hpp"
+#include "Vazel/core/Event/Event.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        /**
+         * @brief InputLogException is thrown when an input log cannot be
+         * written or read
+         *
+         */
+        class InputLogException : public VException
+        {
+          private:
+            std::string _e = "InputLogException: ";
+
+          public:
+            /**
+             * @brief Construct a new Input Log Exception object
+             *
+             * @param e The error message.
+             */
+            InputLogException(const std::string &e);
+
+            /**
+             * @brief Get the what object.
+             *
+             * @return const char* The error message.
+             */
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief A keyboard event and the frame during which it was consumed
+         *
+         */
+        struct InputRecord
+        {
+            uint64_t frame;
+            Keyboard::Input input;
+        };
+
+        /**
+         * @brief InputRecorder stores every keyboard event consumed with
+         * Keyboard::poll or Keyboard::drain, stamped with the frame during
+         * which it was consumed.
+         * Events are stamped at consumption and not when they are pushed so a
+         * replay feeding them back at the beginning of the same frame
+         * reproduces exactly what the application saw.
+         *
+         * The log is a compact binary file:
+         * "VZIL" | version (1 byte) | end frame | record count | records
+         * where every record is the frame delta with the previous record
+         * followed by the input on 1 byte. Integers are LEB128 varints.
+         */
+        class InputRecorder
+        {
+          private:
+            std::vector<InputRecord> _records;
+            uint64_t _frame = 0;
+
+          public:
+            /**
+             * @brief Construct a new Input Recorder object
+             *
+             */
+            InputRecorder(void) = default;
+
+            /**
+             * @brief Destroy the Input Recorder object
+             *
+             */
+            ~InputRecorder(void) = default;
+
+            /**
+             * @brief Set the frame used to stamp the next events (done by
+             * App::run at the beginning of every frame)
+             *
+             * @param frame The current frame
+             */
+            void setFrame(uint64_t frame);
+
+            /**
+             * @brief Record a consumed event at the current frame
+             *
+             * @param input The event
+             */
+            void record(Keyboard::Input input);
+
+            /**
+             * @brief Get the recorded events
+             *
+             * @return const std::vector<InputRecord>& The records
+             */
+            const std::vector<InputRecord> &getRecords(void) const;
+
+            /**
+             * @brief Write the log of the recorded events
+             *
+             * @param path The file to write
+             * @param endFrame The number of frames of the recording (the
+             * replay runs up to this frame)
+             */
+            void save(const std::string &path, uint64_t endFrame) const;
+        };
+
+        /**
+         * @brief InputReplay reads a log written by InputRecorder and pushes
+         * its events back in the Keyboard queue at the frame they were
+         * recorded
+         *
+         */
+        class InputReplay
+        {
+          private:
+            std::vector<InputRecord> _records;
+            uint64_t _end_frame = 0;
+            size_t _next        = 0;
+
+          public:
+            /**
+             * @brief Construct a new Input Replay object from a log
+             *
+             * @param path The log written by InputRecorder::save
+             */
+            InputReplay(const std::string &path);
+
+            /**
+             * @brief Destroy the Input Replay object
+             *
+             */
+            ~InputReplay(void) = default;
+
+            /**
+             * @brief Push the events recorded at this frame in the Keyboard
+             * queue
+             *
+             * @param frame The frame that is about to be updated
+             */
+            void feed(uint64_t frame);
+
+            /**
+             * @brief Check if the replay reached the end of the recording
+             *
+             * @param frame The frame that is about to be updated
+             * @return true If frame is past the end of the recording
+             */
+            bool isFinished(uint64_t frame) const;
+
+            /**
+             * @brief Get the number of frames of the recording
+             *
+             * @return uint64_t The end frame
+             */
+            uint64_t getEndFrame(void) const;
+
+            /**
+             * @brief Get the events of the log
+             *
+             * @return const std::vector<InputRecord>& The records
+             */
+            const std::vector<InputRecord> &getRecords(void) const;
+
+            /**
+             * @brief Restart the replay from the first event
+             *
+             */
+            void rewind(void);
+        };
+
+    } // namespace core
+} // namespace vazel
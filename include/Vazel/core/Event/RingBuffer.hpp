@@ -0,0 +1,177 @@
+/**
+ * include/Vazel/core/Event/RingBuffer.hpp
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        /**
+         * @brief Bounded lock-free queue with many producers and a single
+         * consumer.
+         * Every cell carries a sequence number telling whether it is ready to
+         * be written or read, so producers only race on the head index and
+         * the consumer never waits on a lock.
+         *
+         * @tparam T The type of the elements
+         * @tparam N The capacity (must be a power of two)
+         */
+        template <typename T, size_t N>
+        class RingBuffer
+        {
+            static_assert(N != 0 && (N & (N - 1)) == 0,
+                          "RingBuffer: N must be a power of two");
+
+          private:
+            struct Cell
+            {
+                std::atomic<size_t> sequence;
+                T data;
+            };
+
+            static constexpr size_t _mask = N - 1;
+
+            std::array<Cell, N> _cells;
+            alignas(64) std::atomic<size_t> _head = 0;
+            alignas(64) std::atomic<size_t> _tail = 0;
+
+          public:
+            /**
+             * @brief Construct a new empty Ring Buffer object
+             *
+             */
+            RingBuffer(void)
+            {
+                for (size_t i = 0; i != N; i++) {
+                    _cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            RingBuffer(const RingBuffer &)            = delete;
+            RingBuffer &operator=(const RingBuffer &) = delete;
+
+            /**
+             * @brief Push an element (can be called from any thread)
+             *
+             * @param value The element to push
+             * @return true If the element was pushed
+             * @return false If the buffer is full
+             */
+            bool push(const T &value)
+            {
+                size_t pos = _head.load(std::memory_order_relaxed);
+                Cell *cell = nullptr;
+
+                while (true) {
+                    cell             = &_cells[pos & _mask];
+                    const size_t seq = cell->sequence.load(
+                        std::memory_order_acquire);
+                    const intptr_t diff =
+                        static_cast<intptr_t>(seq) -
+                        static_cast<intptr_t>(pos);
+
+                    if (diff == 0) {
+                        if (_head.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = _head.load(std::memory_order_relaxed);
+                    }
+                }
+                cell->data = value;
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pop the oldest element (must only be called from the
+             * consumer thread)
+             *
+             * @param value Set to the popped element
+             * @return true If an element was popped
+             * @return false If the buffer is empty
+             */
+            bool pop(T &value)
+            {
+                const size_t pos = _tail.load(std::memory_order_relaxed);
+                Cell &cell       = _cells[pos & _mask];
+                const size_t seq =
+                    cell.sequence.load(std::memory_order_acquire);
+
+                if (seq != pos + 1) {
+                    return false;
+                }
+                value = cell.data;
+                cell.sequence.store(pos + N, std::memory_order_release);
+                _tail.store(pos + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /**
+             * @brief Pop as many elements as possible at once (must only be
+             * called from the consumer thread)
+             *
+             * @param out Receives the elements in the order they were pushed
+             * @return size_t The number of elements written in out
+             */
+            size_t drain(std::span<T> out)
+            {
+                size_t count = 0;
+
+                while (count != out.size() && pop(out[count])) {
+                    count++;
+                }
+                return count;
+            }
+
+            /**
+             * @brief Get the number of elements waiting in the buffer (only
+             * an estimation while producers are pushing)
+             *
+             * @return size_t The number of elements
+             */
+            size_t size(void) const
+            {
+                const size_t head = _head.load(std::memory_order_relaxed);
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+
+                return head > tail ? head - tail : 0;
+            }
+
+            /**
+             * @brief Get the maximum number of elements of the buffer
+             *
+             * @return size_t The capacity
+             */
+            static constexpr size_t capacity(void)
+            {
+                return N;
+            }
+        };
+
+    } // namespace core
+} // namespace vazel
@@ -0,0 +1,169 @@
+/**
+ * include/Vazel/core/FrameClock/FrameClock.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        /**
+         * @brief Sleep until deadline. The thread sleeps until shortly before
+         * the deadline then yields until it is reached, sleep alone usually
+         * wakes up too late to hold a stable frame rate.
+         *
+         * @param deadline The time to wake up at
+         */
+        void preciseSleepUntil(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * @brief FrameClock measures the frames of the App and paces them.
+         *
+         * Without a fixed step every frame runs one update and the delta time
+         * is the duration of the previous frame.
+         * With a fixed step the elapsed time is accumulated and each frame
+         * runs as many updates of exactly one step as needed to catch up,
+         * at most getMaxSteps() (the rest is dropped so a long hitch does not
+         * make the simulation spiral).
+         * The clock sleeps at the end of a frame when the frame rate is
+         * limited or when the next fixed step is not due yet.
+         */
+        class FrameClock
+        {
+          public:
+            using clock = std::chrono::steady_clock;
+
+          private:
+            std::chrono::nanoseconds _fixed_step  = {};
+            std::chrono::nanoseconds _frame_limit = {};
+            unsigned _max_steps                   = 5;
+
+            clock::time_point _last_frame;
+            std::chrono::nanoseconds _accumulator = {};
+            std::chrono::nanoseconds _frame_time  = {};
+            uint64_t _dropped_steps               = 0;
+
+          public:
+            /**
+             * @brief Construct a new Frame Clock object (not paced, variable
+             * step)
+             *
+             */
+            FrameClock(void);
+
+            /**
+             * @brief Destroy the Frame Clock object
+             *
+             */
+            ~FrameClock(void) = default;
+
+            /**
+             * @brief Set the fixed simulation step
+             *
+             * @param step The duration of a step (zero for a variable step)
+             */
+            void setFixedStep(std::chrono::nanoseconds step);
+
+            /**
+             * @brief Set the maximum number of steps run in one frame to catch
+             * up with a fixed step
+             *
+             * @param steps The maximum number of steps (at least 1)
+             */
+            void setMaxSteps(unsigned steps);
+
+            /**
+             * @brief Limit the number of frames per second
+             *
+             * @param fps The maximum frame rate (0 for no limit)
+             */
+            void setFrameRateLimit(double fps);
+
+            /**
+             * @brief Get the fixed simulation step
+             *
+             * @return std::chrono::nanoseconds The step (zero if variable)
+             */
+            std::chrono::nanoseconds getFixedStep(void) const;
+
+            /**
+             * @brief Get the maximum number of steps run in one frame
+             *
+             * @return unsigned The maximum number of steps
+             */
+            unsigned getMaxSteps(void) const;
+
+            /**
+             * @brief Restart the measure from now (App::run calls it before
+             * the first frame)
+             *
+             */
+            void reset(void);
+
+            /**
+             * @brief Start a frame
+             *
+             * @return unsigned The number of updates to run during this frame
+             */
+            unsigned beginFrame(void);
+
+            /**
+             * @brief End a frame and sleep if the frame rate is limited or if
+             * the next fixed step is not due yet
+             *
+             */
+            void endFrame(void);
+
+            /**
+             * @brief Get the simulated time of one update in seconds (the
+             * fixed step, or the duration of the last frame)
+             *
+             * @return double The delta time
+             */
+            double getDeltaTime(void) const;
+
+            /**
+             * @brief Get the real duration of the last frame
+             *
+             * @return std::chrono::nanoseconds The frame time
+             */
+            std::chrono::nanoseconds getFrameTime(void) const;
+
+            /**
+             * @brief Get how far the clock is between two fixed steps, to
+             * interpolate the rendering
+             *
+             * @return double The interpolation factor in [0, 1) (0 when the
+             * step is variable)
+             */
+            double getInterpolation(void) const;
+
+            /**
+             * @brief Get the number of fixed steps dropped because a frame
+             * needed more than getMaxSteps() steps
+             *
+             * @return uint64_t The number of dropped steps
+             */
+            uint64_t getDroppedSteps(void) const;
+        };
+
+    } // namespace core
+} // namespace vazel
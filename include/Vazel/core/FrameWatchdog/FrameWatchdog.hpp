@@ -0,0 +1,213 @@
+/**
+ * include/Vazel/core/FrameWatchdog/FrameWatchdog.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/profiling/AllocTracker/AllocTracker.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        /**
+         * @brief FrameWatchdogException is thrown when the slow frames
+         * cannot be written
+         *
+         */
+        class FrameWatchdogException : public VException
+        {
+          private:
+            std::string _e = "FrameWatchdogException: ";
+
+          public:
+            FrameWatchdogException(const std::string &e);
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief The update of a system during a frame
+         *
+         */
+        struct SystemTiming
+        {
+            std::string tag;
+            std::chrono::nanoseconds duration = {};
+            size_t entities                   = 0;
+        };
+
+        /**
+         * @brief The breakdown of a frame over its budget. allocations is
+         * only counted with VAZEL_ENABLE_ALLOC_TRACKING.
+         *
+         */
+        struct SlowFrame
+        {
+            uint64_t frame                    = 0;
+            std::chrono::nanoseconds duration = {};
+            std::chrono::nanoseconds budget   = {};
+            std::vector<SystemTiming> systems;
+            ecs::StructuralChanges changes;
+            profiling::AllocStats allocations;
+        };
+
+        /**
+         * @brief FrameWatchdog captures the frames of App::run longer than a
+         * budget in a ring of SlowFrame, so a rare spike is kept with what
+         * happened during it. It times the systems through the system probe
+         * of the world (the probe it replaces is still notified). Every frame
+         * is measured, a frame under budget costs no allocation.
+         *
+         */
+        class FrameWatchdog : public ecs::SystemProbe
+        {
+          private:
+            std::chrono::nanoseconds _budget = {};
+            std::vector<SlowFrame> _reports;
+            size_t _capacity     = 16;
+            uint64_t _slow_count = 0;
+
+            // The frame in progress, _systems keeps its strings between
+            // frames
+            ecs::SystemProbe *_next = nullptr;
+            std::vector<SystemTiming> _systems;
+            size_t _system_count = 0;
+            std::chrono::steady_clock::time_point _system_begin;
+            ecs::StructuralChanges _changes;
+            profiling::AllocCounter _allocations;
+
+          public:
+            FrameWatchdog(void)  = default;
+            ~FrameWatchdog(void) = default;
+
+            /**
+             * @brief Set the budget of a frame, it is used by the next
+             * App::run
+             *
+             * @param budget The budget (zero disables the watchdog)
+             * @param capacity The number of slow frames kept, the oldest are
+             * dropped
+             */
+            void setBudget(std::chrono::nanoseconds budget,
+                           size_t capacity = 16);
+
+            /**
+             * @brief Get the budget of a frame
+             *
+             * @return std::chrono::nanoseconds The budget (zero if disabled)
+             */
+            std::chrono::nanoseconds getBudget(void) const;
+
+            /**
+             * @brief Check if the frames are watched
+             *
+             * @return bool True if the budget is not zero
+             */
+            bool isEnabled(void) const;
+
+            /**
+             * @brief Start watching the frames of world (App::run)
+             *
+             * @param world The world updated by the frames
+             */
+            void attach(ecs::World &world);
+
+            /**
+             * @brief Stop watching the frames of world and give it its probe
+             * back (App::run)
+             *
+             * @param world The world given to attach
+             */
+            void detach(ecs::World &world);
+
+            /**
+             * @brief Begin a frame (App::run)
+             *
+             * @param world The world updated by the frame
+             */
+            void beginFrame(const ecs::World &world);
+
+            /**
+             * @brief End a frame, it is kept if it is over budget (App::run)
+             *
+             * @param world The world updated by the frame
+             * @param frame The index of the frame
+             * @param duration The duration of the frame
+             */
+            void endFrame(const ecs::World &world, uint64_t frame,
+                          std::chrono::nanoseconds duration);
+
+            /**
+             * @brief Get the counter of the allocations of the frame in
+             * progress (App::run counts them with an AllocScope)
+             *
+             * @return profiling::AllocCounter& The counter
+             */
+            profiling::AllocCounter &allocations(void);
+
+            /**
+             * @brief Get the slow frames kept
+             *
+             * @return std::vector<SlowFrame> The slow frames, oldest first
+             */
+            std::vector<SlowFrame> getReports(void) const;
+
+            /**
+             * @brief Get the number of slow frames since the last clear,
+             * including the dropped ones
+             *
+             * @return uint64_t The number of slow frames
+             */
+            uint64_t getSlowFrameCount(void) const;
+
+            /**
+             * @brief Forget the slow frames
+             *
+             */
+            void clear(void);
+
+            /**
+             * @brief Write the slow frames kept in a text file
+             *
+             * @param path The path of the file
+             * @throw FrameWatchdogException The file cannot be written
+             */
+            void writeReports(const std::string &path) const;
+
+            void onSystemBegin(const ecs::System &system) override;
+            void onSystemEnd(const ecs::System &system) override;
+        };
+
+        /**
+         * @brief Print a slow frame: its duration, its systems from the
+         * slowest, its structural changes and its allocations
+         *
+         * @param os The output stream
+         * @param frame The slow frame
+         * @return std::ostream& The output stream
+         */
+        std::ostream &operator<<(std::ostream &os, const SlowFrame &frame);
+
+    } // namespace core
+} // namespace vazel
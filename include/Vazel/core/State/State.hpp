@@ -20,6 +20,7 @@
 #include "Vazel/VException.hpp"
 #include "Vazel/core/App/App.hpp"
 #include "Vazel/core/_priv.hpp"
+#include "Vazel/ecs/World/World.hpp"
 
 #include <functional>
 #include <memory>
@@ -65,6 +66,7 @@ namespace vazel
             std::function<void(App &)> _on_init;
             std::function<void(App &)> _on_update;
             std::function<void(App &)> _on_exit;
+            std::function<void(ecs::World &)> _on_load;
             StateTag _tag;
             bool _is_running;
 
@@ -101,6 +103,23 @@ namespace vazel
              */
             StateTag getTag(void) const;
 
+            /**
+             * @brief Set the load function of the state, used by
+             * App::setStateAsync to build the world of the state on a
+             * background thread. It only gets the staging world: it must not
+             * touch the App nor anything shared with the running state.
+             *
+             * @param on_load The load function
+             */
+            void setOnLoad(std::function<void(ecs::World &)> on_load);
+
+            /**
+             * @brief Call the load function of the state (if any)
+             *
+             * @param world The world to build
+             */
+            void load(ecs::World &world);
+
             /**
              * @brief Call the init function of the state
              *
@@ -0,0 +1,228 @@
+/**
+ * include/Vazel/core/WorldHost/WorldHost.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        /**
+         * @brief WorldHostException is thrown by the WorldHost when a world
+         * cannot be found.
+         *
+         */
+        class WorldHostException : public VException
+        {
+          private:
+            std::string _e = "WorldHostException: ";
+
+          public:
+            /**
+             * @brief Construct a new World Host Exception object
+             *
+             * @param e The error message.
+             */
+            WorldHostException(const std::string &e);
+
+            /**
+             * @brief Get the what object.
+             *
+             * @return const char* The error message.
+             */
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief Identifier of a World hosted by a WorldHost
+         *
+         */
+        using WorldId = size_t;
+
+        /**
+         * @brief Tick latency of a single hosted World
+         *
+         */
+        struct WorldTickStats
+        {
+            std::chrono::nanoseconds last  = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds min   = std::chrono::nanoseconds::max();
+            std::chrono::nanoseconds max   = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+            uint64_t ticks                 = 0;
+            uint64_t overruns              = 0;
+
+            /**
+             * @brief Get the mean tick latency
+             *
+             * @return std::chrono::nanoseconds The mean latency (0 if the
+             * world never ticked)
+             */
+            std::chrono::nanoseconds mean(void) const;
+        };
+
+        /**
+         * @brief WorldHost owns many independent Worlds and ticks them
+         * concurrently on a pool of worker threads.
+         * Each World is only ever updated by one thread at a time, so the
+         * Worlds must not share any state between them.
+         */
+        class WorldHost
+        {
+          private:
+            struct HostedWorld
+            {
+                ecs::World world;
+                std::chrono::nanoseconds budget;
+                WorldTickStats stats;
+            };
+
+            std::vector<std::unique_ptr<HostedWorld>> _worlds;
+            std::vector<HostedWorld *> _schedule;
+            std::vector<std::thread> _workers;
+
+            std::mutex _mut;
+            std::condition_variable _cv_work;
+            std::condition_variable _cv_done;
+            std::atomic<size_t> _next_job = 0;
+            size_t _busy_workers          = 0;
+            uint64_t _generation          = 0;
+            bool _stopping                = false;
+            std::exception_ptr _error;
+
+            /**
+             * @brief Get the hosted world or throw if it does not exist
+             *
+             * @param id The world id
+             * @return HostedWorld& The hosted world
+             */
+            HostedWorld &__getHostedWorld(WorldId id) const;
+
+            /**
+             * @brief Tick scheduled worlds until none is left for this
+             * generation
+             *
+             */
+            void __runJobs(void);
+
+            /**
+             * @brief Main loop of a worker thread
+             *
+             */
+            void __workerLoop(void);
+
+          public:
+            /**
+             * @brief Construct a new World Host object
+             *
+             * @param workers The number of worker threads (the thread
+             * calling tick() also updates worlds, 0 means that it is the only
+             * one)
+             */
+            WorldHost(size_t workers = std::thread::hardware_concurrency());
+
+            /**
+             * @brief Destroy the World Host object and join the workers
+             *
+             */
+            ~WorldHost(void);
+
+            WorldHost(const WorldHost &)            = delete;
+            WorldHost &operator=(const WorldHost &) = delete;
+
+            /**
+             * @brief Create a new World in the host
+             *
+             * @param budget The time a tick of this world should not exceed
+             * (zero means no budget)
+             * @return WorldId The id of the new world
+             */
+            WorldId addWorld(std::chrono::nanoseconds budget =
+                                 std::chrono::nanoseconds::zero());
+
+            /**
+             * @brief Destroy a World of the host
+             *
+             * @param id The id of the world to remove
+             */
+            void removeWorld(WorldId id);
+
+            /**
+             * @brief Get a hosted World
+             *
+             * @param id The id of the world
+             * @return ecs::World& The world
+             */
+            ecs::World &getWorld(WorldId id);
+
+            /**
+             * @brief Set the frame budget of a World
+             *
+             * @param id The id of the world
+             * @param budget The new budget (zero means no budget)
+             */
+            void setFrameBudget(WorldId id, std::chrono::nanoseconds budget);
+
+            /**
+             * @brief Get the tick latency of a World
+             *
+             * @param id The id of the world
+             * @return const WorldTickStats& The stats of the world
+             */
+            const WorldTickStats &getStats(WorldId id) const;
+
+            /**
+             * @brief Get the number of hosted worlds
+             *
+             * @return size_t The number of worlds
+             */
+            size_t size(void) const;
+
+            /**
+             * @brief Get the number of worker threads
+             *
+             * @return size_t The number of workers
+             */
+            size_t workerCount(void) const;
+
+            /**
+             * @brief Update every hosted World once (World::updateSystem) and
+             * wait for all of them to finish
+             * Worlds that were the slowest on the previous tick are started
+             * first so a long world does not end up alone at the end of the
+             * tick.
+             * If a world throws, the other worlds still finish their tick and
+             * the first exception is rethrown once they are all done.
+             */
+            void tick(void);
+        };
+
+    } // namespace core
+} // namespace vazel
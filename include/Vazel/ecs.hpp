@@ -18,9 +18,20 @@
 
 #pragma once
 
+#include "Vazel/ecs/BatchedWorld/BatchedWorld.hpp"
 #include "Vazel/ecs/Components/Component.hpp"
 #include "Vazel/ecs/Components/ComponentsManager.hpp"
+#include "Vazel/ecs/ComponentPool/ComponentPool.hpp"
 #include "Vazel/ecs/Entity/Entity.hpp"
 #include "Vazel/ecs/Entity/EntityManager.hpp"
+#include "Vazel/ecs/Event/EventChannel.hpp"
+#include "Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp"
+#include "Vazel/ecs/MemoryReport/MemoryReport.hpp"
+#include "Vazel/ecs/Scratch/ScratchArena.hpp"
+#include "Vazel/ecs/Spatial/SpatialGrid.hpp"
 #include "Vazel/ecs/System/System.hpp"
+#include "Vazel/ecs/System/SystemProbe.hpp"
 #include "Vazel/ecs/World/World.hpp"
+#include "Vazel/ecs/WorldArena/WorldArena.hpp"
+#include "Vazel/ecs/WorldMetrics/WorldMetrics.hpp"
+#include "Vazel/ecs/WorldReaper/WorldReaper.hpp"
@@ -0,0 +1,466 @@
+/**
+ * include/Vazel/ecs/BatchedWorld/BatchedWorld.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+#include "Vazel/ecs/Components/Component.hpp"
+#include "Vazel/ecs/Components/ComponentsManager.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief VAZEL_BATCHED_SYSTEM_UPDATE_LAMBDA is a macro to define the update
+ * function of a BatchedSystem. It provides you the BatchedWorld and the mask
+ * of the slots matching the system signature (1 if the slot matches, 0
+ * otherwise)
+ */
+#define VAZEL_BATCHED_SYSTEM_UPDATE_LAMBDA(worldName, maskName, ...) \
+    [__VA_ARGS__](vazel::ecs::BatchedWorld & worldName,              \
+                  std::span<const uint8_t> maskName)
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        class BatchedWorld;
+
+        /**
+         * @brief BatchedWorldException is the base class for all exceptions
+         * thrown by the BatchedWorld class.
+         *
+         */
+        class BatchedWorldException : public VException
+        {
+          private:
+            std::string _e = "BatchedWorldException: ";
+
+          public:
+            /**
+             * @brief Construct a new Batched World Exception object
+             *
+             * @param e the exception message
+             */
+            BatchedWorldException(const std::string &e);
+
+            /**
+             * @brief Get the what object.
+             *
+             * @return const char* The error message.
+             */
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief Index of an entity inside one environment of a BatchedWorld
+         *
+         */
+        using BatchEntity = uint32_t;
+
+        using batchedSystemUpdate =
+            std::function<void(BatchedWorld &, std::span<const uint8_t>)>;
+
+        /**
+         * @brief BatchedSystem is called once per update for every
+         * environment of a BatchedWorld
+         */
+        class BatchedSystem
+        {
+          private:
+            ComponentSignature _signature;
+            std::string _tag;
+            batchedSystemUpdate _on_update;
+
+          public:
+            /**
+             * @brief Construct a new Batched System object
+             *
+             * @param tag System tag
+             */
+            BatchedSystem(const std::string &tag);
+
+            /**
+             * @brief Add a dependency from a ComponentType
+             * @param type Component Type to add as a Dependency
+             */
+            void addDependency(const ComponentType &type);
+
+            /**
+             * @brief Set the system update function
+             *
+             * @param updater System update function
+             */
+            void setOnUpdate(batchedSystemUpdate updater);
+
+            /**
+             * @brief Get the system signature
+             *
+             * @return ComponentSignature System signature
+             */
+            const ComponentSignature &getSignature(void) const;
+
+            /**
+             * @brief Get the system tag
+             *
+             * @return std::string System tag
+             */
+            const std::string &getTag(void) const;
+
+            /**
+             * @brief Call the update function of the system
+             *
+             * @param world The world being updated
+             * @param mask The slots matching the system signature
+             */
+            void onUpdate(BatchedWorld &world,
+                          std::span<const uint8_t> mask) const;
+        };
+
+        /**
+         * @brief BatchedWorld holds N identically-structured environments.
+         * Every environment has the same component registrations and the same
+         * entity capacity, and each component type is stored as one
+         * contiguous array over every slot of every environment:
+         * slot = environment * capacity + entity.
+         * A BatchedSystem is therefore invoked once for all the environments
+         * and can run plain loops over the columns.
+         */
+        class BatchedWorld
+        {
+          private:
+            struct ColumnBase
+            {
+                virtual ~ColumnBase(void)       = default;
+                virtual void reset(size_t slot) = 0;
+            };
+
+            template <typename T>
+            struct Column : public ColumnBase
+            {
+                std::vector<T> data;
+
+                Column(size_t slots)
+                    : data(slots)
+                {
+                }
+
+                void reset(size_t slot) override
+                {
+                    data[slot] = T();
+                }
+            };
+
+            struct SystemEntry
+            {
+                BatchedSystem system;
+                std::vector<uint8_t> mask;
+            };
+
+            size_t _environments;
+            size_t _capacity;
+            ComponentMap _components_map;
+            ComponentSignature _aviable_signatures;
+            std::array<std::unique_ptr<ColumnBase>, VAZEL_MAX_COMPONENTS>
+                _columns;
+            std::vector<ComponentSignature> _signatures;
+            std::vector<uint8_t> _alive;
+            std::vector<std::vector<BatchEntity>> _free_entities;
+            std::vector<SystemEntry> _systems;
+            bool _masks_dirty = false;
+
+            /**
+             * @brief Get the slot of an entity and check that it is alive
+             *
+             * @param env The environment
+             * @param e The entity
+             * @return size_t The slot
+             */
+            size_t __getSlot(size_t env, BatchEntity e) const;
+
+            /**
+             * @brief Get the component type of T or throw if it is not
+             * registered
+             *
+             * @tparam T The component
+             * @return ComponentType The component type
+             */
+            template <typename T>
+            ComponentType __getComponentType(void) const
+            {
+                const auto it = _components_map.find(typeid(T).name());
+
+                if (it == _components_map.end()) {
+                    std::string err = "BatchedWorld: Component is not "
+                                      "registered: ";
+                    err += typeid(T).name();
+                    throw BatchedWorldException(err);
+                }
+                return it->second;
+            }
+
+            /**
+             * @brief Recompute the masks of the systems
+             *
+             */
+            void __updateMasks(void);
+
+          public:
+            /**
+             * @brief Construct a new Batched World object
+             *
+             * @param environments The number of environments
+             * @param capacity The maximum number of entities per environment
+             */
+            BatchedWorld(size_t environments, size_t capacity);
+
+            /**
+             * @brief Destroy the Batched World object
+             *
+             */
+            ~BatchedWorld(void) = default;
+
+            /**
+             * @brief Get the number of environments
+             *
+             * @return size_t The number of environments
+             */
+            size_t environments(void) const;
+
+            /**
+             * @brief Get the number of entity slots per environment
+             *
+             * @return size_t The capacity of an environment
+             */
+            size_t capacity(void) const;
+
+            /**
+             * @brief Get the total number of slots (environments * capacity),
+             * this is the size of every column
+             *
+             * @return size_t The number of slots
+             */
+            size_t slots(void) const;
+
+            /**
+             * @brief Get the slot of an entity in the columns
+             *
+             * @param env The environment of the entity
+             * @param e The entity
+             * @return size_t The slot
+             */
+            size_t slotOf(size_t env, BatchEntity e) const;
+
+            /**
+             * @brief Register a Component in every environment
+             *
+             * @tparam T The type of the component.
+             * @return ComponentType The component type
+             */
+            template <typename T>
+            ComponentType registerComponent(void)
+            {
+                const char *name = typeid(T).name();
+                const auto it    = _components_map.find(name);
+
+                if (it != _components_map.end()) {
+                    return it->second;
+                }
+                for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                    if (_aviable_signatures.test(i) == false) {
+                        _aviable_signatures.set(i, true);
+                        _components_map.emplace(name, i);
+                        _columns[i] = std::make_unique<Column<T>>(slots());
+                        return i;
+                    }
+                }
+                throw BatchedWorldException(
+                    "BatchedWorld::registerComponent<T>: You registered "
+                    "already the maximum of Component");
+            }
+
+            /**
+             * @brief Get the Component Type object
+             *
+             * @tparam T Type of the component that you want to get
+             * @return ComponentType The ComponentType
+             */
+            template <typename T>
+            ComponentType getComponentType(void) const
+            {
+                return __getComponentType<T>();
+            }
+
+            /**
+             * @brief Create an Entity in an environment
+             *
+             * @param env The environment
+             * @return BatchEntity The new entity
+             */
+            BatchEntity createEntity(size_t env);
+
+            /**
+             * @brief Remove an Entity from an environment
+             *
+             * @param env The environment
+             * @param e The entity to remove
+             */
+            void removeEntity(size_t env, BatchEntity e);
+
+            /**
+             * @brief Remove every Entity of an environment (the registrations
+             * are kept)
+             *
+             * @param env The environment to reset
+             */
+            void resetEnvironment(size_t env);
+
+            /**
+             * @brief Attach a Component to an Entity
+             *
+             * @tparam T The type of the component.
+             * @param env The environment of the entity
+             * @param e The entity to attach the component to.
+             * @param data The data of the component.
+             */
+            template <typename T>
+            void attachComponent(size_t env, BatchEntity e, const T &data)
+            {
+                const ComponentType type = __getComponentType<T>();
+                const size_t slot        = __getSlot(env, e);
+
+                if (_signatures[slot].test(type)) {
+                    throw BatchedWorldException(
+                        "BatchedWorld::attachComponent<T>: You cannot attach "
+                        "a component that is already attached");
+                }
+                column<T>()[slot] = data;
+                _signatures[slot].set(type, true);
+                _masks_dirty = true;
+            }
+
+            /**
+             * @brief Attach a Component to an Entity (with a default value for
+             * T)
+             *
+             * @tparam T The type of the component.
+             * @param env The environment of the entity
+             * @param e The entity to attach the component to.
+             */
+            template <typename T>
+            void attachComponent(size_t env, BatchEntity e)
+            {
+                attachComponent<T>(env, e, T());
+            }
+
+            /**
+             * @brief Detach a Component from an Entity
+             *
+             * @tparam T The type of the component.
+             * @param env The environment of the entity
+             * @param e The entity to detach the component from.
+             */
+            template <typename T>
+            void detachComponent(size_t env, BatchEntity e)
+            {
+                const ComponentType type = __getComponentType<T>();
+                const size_t slot        = __getSlot(env, e);
+
+                _columns[type]->reset(slot);
+                _signatures[slot].set(type, false);
+                _masks_dirty = true;
+            }
+
+            /**
+             * @brief Get the Component of an Entity
+             *
+             * @tparam T The type of the component.
+             * @param env The environment of the entity
+             * @param e The entity
+             * @return T& The component
+             */
+            template <typename T>
+            T &getComponent(size_t env, BatchEntity e)
+            {
+                const ComponentType type = __getComponentType<T>();
+                const size_t slot        = __getSlot(env, e);
+
+                if (_signatures[slot].test(type) == false) {
+                    char buf[BUFSIZ] = { 0 };
+                    std::snprintf(buf, sizeof(buf) - 1,
+                                  "BatchedWorld::getComponent: Entity(%u) of "
+                                  "environment %lu has no Component(%s)",
+                                  e, env, typeid(T).name());
+                    throw BatchedWorldException(buf);
+                }
+                return column<T>()[slot];
+            }
+
+            /**
+             * @brief Get the column of a Component over every slot of every
+             * environment. Slots without the component hold a default T.
+             *
+             * @tparam T The type of the component.
+             * @return std::span<T> The column
+             */
+            template <typename T>
+            std::span<T> column(void)
+            {
+                const ComponentType type = __getComponentType<T>();
+
+                return std::span<T>(
+                    static_cast<Column<T> *>(_columns[type].get())->data);
+            }
+
+            /**
+             * @brief Get the signature of every slot (an empty signature
+             * means that the slot is not used or has no component)
+             *
+             * @return std::span<const ComponentSignature> The signatures
+             */
+            std::span<const ComponentSignature> signatures(void) const;
+
+            /**
+             * @brief Add a BatchedSystem to the world
+             *
+             * @param sys The system to add. (with at least one dependency)
+             */
+            void registerSystem(const BatchedSystem &sys);
+
+            /**
+             * @brief Remove a BatchedSystem from the world
+             *
+             * @param tag The tag of the system to remove.
+             */
+            void removeSystem(const std::string &tag);
+
+            /**
+             * @brief Update every system once for all the environments
+             *
+             */
+            void updateSystem(void);
+        };
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,331 @@
+/**
+ * include/Vazel/ecs/ComponentPool/ComponentPool.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/Components/Component.hpp"
+#include "Vazel/ecs/Entity/Entity.hpp"
+#include "Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The number of entity indices covered by a page of a Paged pool
+ *
+ */
+#define VAZEL_COMPONENT_PAGE_SIZE 4096
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief How the values of a component type are stored
+         *
+         * Dense: a slot per entity index, the value of an entity is found
+         * without indirection. For the components on (almost) every entity.
+         *
+         * Sparse: a sparse set, the values are packed and an array over the
+         * entity indices gives their position. Iterating visits only the
+         * values, the index array costs 4 bytes per entity.
+         *
+         * Paged: a sparse set whose index array is allocated by pages of
+         * VAZEL_COMPONENT_PAGE_SIZE indices, only the pages holding a value
+         * are allocated. For the rare components.
+         */
+        enum class ComponentStorage
+        {
+            Dense,
+            Sparse,
+            Paged,
+        };
+
+        /**
+         * @brief ComponentPool stores the values of one component type by
+         * entity index, allocated from a memory resource. The values are
+         * moved (see ComponentVTable::relocate) when the pool grows and, for
+         * the sparse storages, when a value is erased: a reference to a value
+         * is only valid until the next emplace or erase.
+         *
+         */
+        class ComponentPool
+        {
+          private:
+            static constexpr EntityIndex npos = ~EntityIndex(0);
+
+            std::pmr::memory_resource *_resource;
+            ComponentStorage _storage      = ComponentStorage::Sparse;
+            const ComponentVTable *_vtable = nullptr;
+            std::byte *_values             = nullptr;
+            size_t _capacity               = 0;
+            size_t _size                   = 0;
+            // Dense: the indices holding a value
+            HierarchicalBitset _present;
+            // Sparse and Paged: the index of every packed value
+            std::pmr::vector<EntityIndex> _packed;
+            // Sparse: the position of the value of every index
+            std::pmr::vector<EntityIndex> _sparse;
+            // Paged: _sparse split in pages, nullptr until used
+            std::pmr::vector<EntityIndex *> _pages;
+
+            /**
+             * @brief Get the position of the value of an index
+             *
+             * @return EntityIndex* The position (npos if there is no value),
+             * nullptr if the index is not covered
+             */
+            EntityIndex *__position(EntityIndex index) const
+            {
+                if (_storage == ComponentStorage::Sparse) {
+                    return index < _sparse.size()
+                               ? const_cast<EntityIndex *>(&_sparse[index])
+                               : nullptr;
+                }
+                const size_t page = index / VAZEL_COMPONENT_PAGE_SIZE;
+
+                if (page >= _pages.size() || _pages[page] == nullptr) {
+                    return nullptr;
+                }
+                return _pages[page] + index % VAZEL_COMPONENT_PAGE_SIZE;
+            }
+
+            /**
+             * @brief Get the position of the value of an index, covering it
+             *
+             */
+            EntityIndex &__makePosition(EntityIndex index);
+
+            /**
+             * @brief Move the values to a buffer of capacity values
+             *
+             */
+            void __reserve(size_t capacity);
+
+            /**
+             * @brief Get the raw memory of the value of an index, before
+             * constructing it
+             *
+             */
+            void *__prepare(EntityIndex index);
+
+            /**
+             * @brief Record the value constructed at __prepare(index)
+             *
+             */
+            void __commit(EntityIndex index);
+
+            /**
+             * @brief Check if an address is in the buffer of the values
+             *
+             */
+            bool __holds(const void *address) const;
+
+            void *__at(size_t slot) const
+            {
+                return _values + slot * _vtable->size;
+            }
+
+          public:
+            /**
+             * @brief Construct a new empty Component Pool object, it stores
+             * nothing until configure is called
+             *
+             * @param resource The memory resource of the values and indices
+             */
+            ComponentPool(std::pmr::memory_resource *resource =
+                              std::pmr::get_default_resource());
+
+            /**
+             * @brief Take the values of another pool
+             *
+             * @param other The pool to move from, it is left empty
+             */
+            ComponentPool(ComponentPool &&other) noexcept;
+
+            /**
+             * @brief Destroy the values then take the ones of another pool
+             * (they must use the same memory resource)
+             *
+             * @param other The pool to move from, it is left empty
+             * @return ComponentPool& A reference to *this
+             */
+            ComponentPool &operator=(ComponentPool &&other) noexcept;
+
+            ComponentPool(const ComponentPool &) = delete;
+            ComponentPool &operator=(const ComponentPool &) = delete;
+
+            /**
+             * @brief Destroy the Component Pool object and its values
+             *
+             */
+            ~ComponentPool(void);
+
+            /**
+             * @brief Set the type and the storage of the values, the pool
+             * must be empty
+             *
+             * @param storage The storage
+             * @param vtable The type of the values (see getComponentVTable)
+             */
+            void configure(ComponentStorage storage,
+                           const ComponentVTable *vtable);
+
+            ComponentStorage getStorage(void) const;
+            const ComponentVTable *getVTable(void) const;
+
+            /**
+             * @brief Get the number of values
+             *
+             * @return size_t The number of values
+             */
+            size_t size(void) const;
+
+            /**
+             * @brief Check if an index has a value
+             *
+             * @param index The entity index
+             * @return bool True if it has one
+             */
+            bool contains(EntityIndex index) const;
+
+            /**
+             * @brief Get the value of an index
+             *
+             * @param index The entity index
+             * @return void* The value, nullptr if it has none
+             */
+            void *find(EntityIndex index) const
+            {
+                if (_storage == ComponentStorage::Dense) {
+                    return _present.test(index) ? __at(index) : nullptr;
+                }
+                const EntityIndex *position = __position(index);
+
+                if (position == nullptr || *position == npos) {
+                    return nullptr;
+                }
+                return __at(*position);
+            }
+
+            /**
+             * @brief Copy a value for an index that has none
+             *
+             * @tparam T The configured type
+             * @param index The entity index
+             * @param data The value to copy
+             * @return T& The stored value
+             */
+            template <typename T>
+            T &emplace(EntityIndex index, const T &data)
+            {
+                if (__holds(&data)) {
+                    // data moves if the pool grows, it is copied out first
+                    T copy(data);
+
+                    return emplace<T>(index, std::move(copy));
+                }
+                T *value = new (__prepare(index)) T(data);
+
+                __commit(index);
+                return *value;
+            }
+
+            /**
+             * @brief Move a value for an index that has none
+             *
+             * @tparam T The configured type
+             * @param index The entity index
+             * @param data The value to move, not stored in this pool
+             * @return T& The stored value
+             */
+            template <typename T>
+            T &emplace(EntityIndex index, T &&data)
+            {
+                T *value = new (__prepare(index)) T(std::move(data));
+
+                __commit(index);
+                return *value;
+            }
+
+            /**
+             * @brief Destroy the value of an index
+             *
+             * @param index The entity index
+             * @return bool False if it had no value
+             */
+            bool erase(EntityIndex index);
+
+            /**
+             * @brief Destroy every value and release the memory, the
+             * configuration is kept
+             *
+             */
+            void clear(void);
+
+            /**
+             * @brief Exchange the content of two pools in O(1) (they must
+             * use the same memory resource)
+             *
+             * @param other The pool to swap with
+             */
+            void swap(ComponentPool &other);
+
+            /**
+             * @brief Get the bytes reserved for the values
+             *
+             * @return size_t The capacity times the size of a value
+             */
+            size_t getValueBytes(void) const;
+
+            /**
+             * @brief Get the bytes reserved to find the values (index arrays,
+             * pages or presence bits)
+             *
+             * @return size_t The bytes
+             */
+            size_t getIndexBytes(void) const;
+
+            /**
+             * @brief Call f with every index having a value, the pool may not
+             * change during the call. Dense pools visit the indices in
+             * increasing order, sparse ones in the order of their values.
+             *
+             * @tparam F void(EntityIndex index)
+             * @param f The function
+             */
+            template <typename F>
+            void forEach(F &&f) const
+            {
+                if (_storage == ComponentStorage::Dense) {
+                    _present.forEach([&f](size_t index) {
+                        f(static_cast<EntityIndex>(index));
+                    });
+                    return;
+                }
+                for (size_t i = 0; i != _size; i++) {
+                    f(_packed[i]);
+                }
+            }
+        };
+
+    } // namespace ecs
+} // namespace vazel
@@ -17,11 +17,11 @@
  */
 #pragma once
 
-#include "Vazel/VException.hpp"
-
-#include <any>
 #include <bitset>
-#include <stdlib.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
 
 /**
  * @brief The maximum number of components.
@@ -41,86 +41,43 @@ namespace vazel
         using ComponentType = uint_fast16_t;
 
         /**
-         * @brief CompoenentExistsException is thrown when a component is
-         * already added to an entity.
+         * @brief What a ComponentPool needs to know about the type it stores
+         * to destroy, move and free it. relocate moves the value of src to
+         * the raw memory dst then destroys src.
          *
          */
-        class ComponentExistsException : public VException
+        struct ComponentVTable
         {
-          private:
-            std::string _e;
-
-          public:
-            /**
-             * @brief Construct a new Component Exists Exception object
-             *
-             * @param e The error message.
-             */
-            ComponentExistsException(const std::string &e);
-
-            /**
-             * @brief Get the what object.
-             *
-             * @return const char* The error message.
-             */
-            const char *what() const throw() override;
+            void (*destroy)(void *);
+            void (*relocate)(void *dst, void *src);
+            size_t size;
+            size_t align;
         };
 
-        class Component
+        /**
+         * @brief Get the ComponentVTable of T, there is one per type so the
+         * address identifies the type
+         *
+         * @tparam T The type of the component
+         * @return const ComponentVTable* The vtable of T
+         */
+        template <typename T>
+        const ComponentVTable *getComponentVTable(void)
         {
-          private:
-            std::any _data;
-
-          public:
-            /**
-             * @brief Construct a new T object with an initial value.
-             *
-             * @tparam T The type of the component.
-             * @param data The initial value of the component.
-             */
-            template <typename T>
-            void make(T &data)
-            {
-                if (_data.has_value()) {
-                    throw ComponentExistsException(
-                        "Component::make<T>: Component is not null and you "
-                        "are "
-                        "trying to make a new one.");
-                }
-                _data = data;
-            }
-            /**
-             * @brief Destroy the _data object but not the Component class.
-             */
-            void remove(void);
-
-            /**
-             * @brief Construct a new Component object
-             *
-             */
-            Component(void) = default;
-
-            /**
-             * @brief Destroy the Component object
-             */
-            ~Component(void);
-
-            /**
-             * @brief Wrapper around get_ref
-             * @tparam Type to use around get_ref
-             * @return T& A reference by the object return by get_reg
-             */
-            template <typename T>
-            T &get(void)
-            {
-                return std::any_cast<T &>(_data);
-            }
-
-            bool hasValue(void) const
-            {
-                return _data.has_value();
-            }
-        };
+            static const ComponentVTable vtable = {
+                [](void *data) { static_cast<T *>(data)->~T(); },
+                [](void *dst, void *src) {
+                    T *value = static_cast<T *>(src);
+
+                    new (dst) T(std::move(*value));
+                    value->~T();
+                },
+                sizeof(T),
+                alignof(T),
+            };
+
+            return &vtable;
+        }
 
         /**
          * @brief Component that can be attached to an entity.
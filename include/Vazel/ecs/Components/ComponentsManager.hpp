@@ -18,15 +18,20 @@
 #pragma once
 
 #include "Vazel/VException.hpp"
+#include "Vazel/ecs/ComponentPool/ComponentPool.hpp"
 #include "Vazel/ecs/Components/Component.hpp"
 #include "Vazel/ecs/Entity/Entity.hpp"
+#include "Vazel/ecs/Entity/EntityManager.hpp"
 
 #include <cstdio>
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace vazel
 {
@@ -62,7 +67,7 @@ namespace vazel
         /**
          * @brief ComponentManagerRegisterError class determines if a component
          * is already registered or the number of components is already at
-         * vazel::ecs::Component::MAX
+         * VAZEL_MAX_COMPONENTS
          */
         class ComponentManagerRegisterError : public ComponentManagerException
         {
@@ -82,22 +87,24 @@ namespace vazel
          */
         using ComponentMap = std::unordered_map<const char *, ComponentType>;
 
-        /**
-         * @brief ComponentArray is an array of Components of size
-         * VAZEL_MAX_COMPONENTS
-         */
-        using ComponentArray = std::array<Component, VAZEL_MAX_COMPONENTS>;
-
         /**
          * @brief ComponentsManager class
-         *      Manages all components of an Entity
+         *      Manages all components of an Entity. The components of a
+         *      type are stored in a ComponentPool by the dense index the
+         *      EntityManager gives to the entity, with the storage chosen
+         *      when the type is registered. The EntityManager is the one of
+         *      the World, or one owned by the ComponentManager when it is
+         *      used alone (the entities are then added by onEntityCreate).
          */
         class ComponentManager
         {
           private:
+            std::unique_ptr<EntityManager> _own_entities;
+            const EntityManager *_entities;
+            std::pmr::memory_resource *_resource;
             ComponentMap _components_map;
             ComponentSignature _aviable_signatures;
-            std::unordered_map<Entity, ComponentArray> _entity_to_components;
+            std::vector<ComponentPool> _pools;
 
             /**
              * @brief get the component type from the component name
@@ -106,11 +113,45 @@ namespace vazel
              */
             ComponentType _getAviableComponentIndex(void);
 
+            /**
+             * @brief Get the value of a component of an entity
+             *
+             * @return void* The value, nullptr if the entity is not
+             * registered or has no such component
+             */
+            void *__find(ComponentType type, const Entity &e) const;
+
           public:
             /**
-             * @brief Construct a new Component Manager object
+             * @brief Construct a new Component Manager object owning its
+             * EntityManager, the entities are added by onEntityCreate
+             *
+             * @param resource The memory resource of the components and of
+             * their containers
+             */
+            ComponentManager(std::pmr::memory_resource *resource =
+                                 std::pmr::get_default_resource());
+
+            /**
+             * @brief Construct a new Component Manager object sharing the
+             * index of an EntityManager
+             *
+             * @param entities The EntityManager giving the index of the
+             * entities, it must outlive the Component Manager
+             * @param resource The memory resource of the components and of
+             * their containers
+             */
+            ComponentManager(const EntityManager &entities,
+                             std::pmr::memory_resource *resource =
+                                 std::pmr::get_default_resource());
+
+            /**
+             * @brief Take the components of another Component Manager (the
+             * components are move only, it cannot be copied)
+             *
+             * @param other The Component Manager to move from
              */
-            ComponentManager(void) = default;
+            ComponentManager(ComponentManager &&other) = default;
 
             /**
              * @brief Destroy the Component Manager object
@@ -120,6 +161,23 @@ namespace vazel
             const ComponentMap &getComponentMap(void) const;
             const ComponentSignature &getComponentSignature(void) const;
 
+            /**
+             * @brief Get the values of a component type
+             *
+             * @param type The component type
+             * @return const ComponentPool& The pool of the type
+             */
+            const ComponentPool &getPool(ComponentType type) const;
+
+            /**
+             * @brief Get the number of components of a type attached to the
+             * entities, in O(1)
+             *
+             * @param type The component type
+             * @return size_t The number of attached components
+             */
+            size_t getComponentCount(ComponentType type) const;
+
             /**
              * @brief shows the current state of the ComponentManager
              *
@@ -132,10 +190,13 @@ namespace vazel
              * value
              *
              * @tparam T The componentType to register
+             * @param storage How the values are stored (see ComponentStorage),
+             * a type registered already keeps its storage
              * @return ComponentType the current component type
              */
             template <typename T>
-            const ComponentType registerComponent(void)
+            const ComponentType registerComponent(
+                ComponentStorage storage = ComponentStorage::Sparse)
             {
                 const char *name                 = typeid(T).name();
                 const ComponentType aviableIndex = _getAviableComponentIndex();
@@ -148,6 +209,8 @@ namespace vazel
                 }
                 _aviable_signatures.set(aviableIndex, true);
                 _components_map.emplace(name, aviableIndex);
+                _pools[aviableIndex].configure(storage,
+                                               getComponentVTable<T>());
                 return aviableIndex;
             }
 
@@ -173,9 +236,7 @@ namespace vazel
                     throw ComponentManagerRegisterError(err);
                 }
                 _components_map.erase(name);
-                for (auto &it : _entity_to_components) {
-                    it.second[position].remove();
-                }
+                _pools[position].clear();
             }
 
             /**
@@ -202,14 +263,16 @@ namespace vazel
             }
 
             /**
-             * @brief Should always be called to register the entity
-             * @return ComponentManager& The class itself
+             * @brief Should always be called to register the entity when the
+             * ComponentManager owns its EntityManager. With a shared
+             * EntityManager, the entity must have been created by it.
              *
              */
             void onEntityCreate(const Entity &e);
 
             /**
-             * @brief Should always be called to unregister an entity
+             * @brief Should always be called to unregister an entity, before
+             * a shared EntityManager destroys it
              *
              */
             void onEntityDestroy(const Entity &e);
@@ -230,30 +293,33 @@ namespace vazel
 
                 try {
                     const auto itcomponentType = _components_map.find(name);
-                    auto it                    = _entity_to_components.find(e);
+                    const EntityIndex *index    = _entities->findIndex(e);
                     ComponentType componentType = -1;
-                    if (it == _entity_to_components.end()) {
-#ifdef UNALLOW_DYNAMIC_COMPONENT_REGISTER
+                    if (index == nullptr) {
                         throw ComponentManagerException(
                             "ComponentManager::attachComponent<T>: You cannot "
                             "attach a component to a non registered Entity");
-#else
-                        componentType = registerComponent<T>();
-#endif
                     }
 
                     if (itcomponentType == _components_map.end()) {
-                        registerComponent<T>();
-                        componentType = _components_map.at(name);
+#ifdef UNALLOW_DYNAMIC_COMPONENT_REGISTER
+                        throw ComponentManagerException(
+                            "ComponentManager::attachComponent<T>: You cannot "
+                            "attach a component that is not registered");
+#else
+                        componentType = registerComponent<T>();
+#endif
                     } else {
                         componentType = itcomponentType->second;
                     }
-                    if (it->second[componentType].hasValue()) {
+                    ComponentPool &pool = _pools[componentType];
+
+                    if (pool.contains(*index)) {
                         throw ComponentManagerException(
                             "ComponentManager::attachComponent<T>: You cannot "
                             "attach a component that is already attached");
                     }
-                    it->second[componentType].make<T>(data);
+                    pool.emplace<T>(*index, data);
                 } catch (std::exception &e) {
                     std::string err = e.what();
                     err += " -> ";
@@ -290,9 +356,9 @@ namespace vazel
             void detachComponent(const Entity &e)
             {
                 const ComponentType type = getComponentType<T>();
-                const auto it            = _entity_to_components.find(e);
+                const EntityIndex *index = _entities->findIndex(e);
 
-                if (it == _entity_to_components.end()) {
+                if (index == nullptr) {
                     std::string err =
                         "ComponentManager::detachComponent<T>: You "
                         "cannot detach a "
@@ -300,7 +366,7 @@ namespace vazel
                     err += typeid(T).name();
                     throw ComponentManagerRegisterError(err.c_str());
                 }
-                it->second[type].remove();
+                _pools[type].erase(*index);
                 // maybe throw an exception if the component is not attached
                 // Depends if it should work like a free
                 // .remove on Component should check already if component is
@@ -309,7 +375,10 @@ namespace vazel
 
             /**
              * @brief getComponent gets the Component of a specifically
-             * attached Entity
+             * attached Entity. The reference is valid until a T is attached
+             * to or detached from any entity (or an entity having one is
+             * destroyed): the pool of T moves its values when it grows or
+             * fills the hole of an erased value. Get it again after those.
              *
              * @tparam T The componentType to get
              * @param e The Entity to get the Component from
@@ -319,17 +388,13 @@ namespace vazel
             T &getComponent(const Entity &e)
             {
                 const char *name = typeid(T).name();
+                const auto type  = _components_map.find(name);
+                void *value      = nullptr;
 
-                try {
-                    const ComponentType componentType =
-                        _components_map.at(name);
-                    const auto it = _entity_to_components.find(e);
-
-                    if (it == _entity_to_components.end()) {
-                        throw std::runtime_error("");
-                    }
-                    return it->second[componentType].get<T>();
-                } catch (...) {
+                if (type != _components_map.end()) {
+                    value = __find(type->second, e);
+                }
+                if (value == nullptr) {
                     char buf[BUFSIZ] = { 0 };
                     std::snprintf(
                         buf, sizeof(buf) - 1,
@@ -339,6 +404,46 @@ namespace vazel
                         e.getId(), name);
                     throw ComponentManagerException(std::string(buf));
                 }
+                return *static_cast<T *>(value);
+            }
+
+            /**
+             * @brief Call f with every entity having all the components Ts
+             * and its components. The entities of the smallest pool are
+             * visited and looked up in the others, so a rare component
+             * bounds the work. The entities and their components may not be
+             * added or removed during the call.
+             *
+             *     cm.join<Position, Velocity>(
+             *         [](const Entity &e, Position &p, Velocity &v) {...});
+             *
+             * @tparam Ts The registered components to join
+             * @param f void(const Entity &, Ts &...)
+             */
+            template <typename... Ts, typename F>
+            void join(F &&f)
+            {
+                static_assert(sizeof...(Ts) != 0, "join needs a component");
+                const ComponentPool *pools[] = {
+                    &_pools[getComponentType<Ts>()]...
+                };
+                const ComponentPool *smallest = pools[0];
+
+                for (const ComponentPool *it : pools) {
+                    if (it->size() < smallest->size()) {
+                        smallest = it;
+                    }
+                }
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    smallest->forEach([&](EntityIndex index) {
+                        void *values[] = { pools[I]->find(index)... };
+
+                        if (((values[I] != nullptr) && ...)) {
+                            f(_entities->getEntity(index),
+                              *static_cast<Ts *>(values[I])...);
+                        }
+                    });
+                }(std::index_sequence_for<Ts...>());
             }
 
             /**
@@ -346,6 +451,15 @@ namespace vazel
              *
              */
             void clear(void);
+
+            /**
+             * @brief Exchange the content of two ComponentManagers in O(1)
+             * (they must use the same memory resource). A shared
+             * EntityManager stays, swap them too; an owned one is swapped.
+             *
+             * @param other The ComponentManager to swap with
+             */
+            void swap(ComponentManager &other);
         };
 
         /**
@@ -19,6 +19,7 @@
 
 #include "Vazel/UUID.hpp"
 
+#include <cstdint>
 #include <functional>
 
 namespace vazel
@@ -26,6 +27,13 @@ namespace vazel
     namespace ecs
     {
 
+        /**
+         * @brief The dense index of an entity in a manager, reused once the
+         * entity is destroyed
+         *
+         */
+        using EntityIndex = uint32_t;
+
         /**
          * @brief The Entity class
          * This class is the base class for all entities in the game.
@@ -48,6 +56,14 @@ namespace vazel
              */
             Entity(const Entity &uuid);
 
+            /**
+             * @brief Copy the UUID of another entity
+             *
+             * @param other The entity to copy
+             * @return Entity& This entity
+             */
+            Entity &operator=(const Entity &other) = default;
+
             /**
              * @brief Wrapper to get the UUID
              *
@@ -20,9 +20,13 @@
 #include "Vazel/VException.hpp"
 #include "Vazel/ecs/Components/Component.hpp"
 #include "Vazel/ecs/Entity/Entity.hpp"
+#include "Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp"
 
+#include <array>
+#include <memory_resource>
 #include <string.h>
 #include <unordered_map>
+#include <vector>
 
 namespace vazel
 {
@@ -74,22 +78,82 @@ namespace vazel
         };
 
         /**
-         * @brief EntityMap is a map of entities and their components.
+         * @brief The components and the dense index of an entity
          *
          */
-        using EntityMap = std::unordered_map<Entity, ComponentSignature>;
+        struct EntityRecord
+        {
+            ComponentSignature signature;
+            EntityIndex index = 0;
+        };
+
+        /**
+         * @brief EntityMap is a map of entities and their records.
+         *
+         */
+        using EntityMap = std::pmr::unordered_map<Entity, EntityRecord>;
 
+        /**
+         * @brief EntityManager gives every entity a dense index and keeps,
+         * per component type, the set of the indices of the entities having
+         * it (see join)
+         *
+         */
         class EntityManager
         {
           private:
             EntityMap _entity_map;
+            std::pmr::vector<Entity> _index_entities;
+            std::pmr::vector<EntityIndex> _free_indices;
+            HierarchicalBitset _alive;
+            std::vector<HierarchicalBitset> _component_sets;
+            // Signatures given by reference, indexed again before a join
+            HierarchicalBitset _dirty;
+
+            /**
+             * @brief Get the record of an entity
+             *
+             * @throws EntityManagerExceptionFindEntityError if the entity is
+             * not found.
+             */
+            EntityRecord &__getRecord(const Entity &e, const char *caller);
+
+            /**
+             * @brief Get the record of an entity
+             *
+             * @throws EntityManagerExceptionFindEntityError if the entity is
+             * not found.
+             */
+            const EntityRecord &__getRecord(const Entity &e,
+                                            const char *caller) const;
+
+            /**
+             * @brief Give an index to an entity and add it without component
+             *
+             */
+            EntityRecord &__insert(const Entity &e);
+
+            /**
+             * @brief Set the bits of an entity in the component sets
+             *
+             */
+            void __indexSignature(EntityIndex index,
+                                  const ComponentSignature &signature);
+
+            /**
+             * @brief Index the signatures changed through a reference
+             *
+             */
+            void __sync(void);
 
           public:
             /**
              * @brief Construct a new Entity Manager object
              *
+             * @param resource The memory resource of the entity map
              */
-            EntityManager(void) = default;
+            EntityManager(std::pmr::memory_resource *resource =
+                              std::pmr::get_default_resource());
 
             /**
              * @brief Destroy the Entity Manager object
@@ -117,7 +181,7 @@ namespace vazel
             void destroyEntity(Entity &e);
 
             /**
-             * @brief Set the Signature object
+             * @brief Set the Signature object, an unknown entity is added
              *
              * @param e The entity.
              * @param signature The signature.
@@ -126,13 +190,120 @@ namespace vazel
                               const ComponentSignature &signature);
 
             /**
-             * @brief Get the Signature object
+             * @brief Set or unset a component in the signature of an entity
+             *
+             * @param e The entity.
+             * @param type The component type.
+             * @param attached True if the entity has the component.
+             */
+            void setComponent(const Entity &e, ComponentType type,
+                              bool attached);
+
+            /**
+             * @brief Get the Signature object, an unknown entity is added.
+             * The entity is indexed again by the next join, prefer
+             * setSignature or setComponent.
              *
              * @param e The entity.
              * @return ComponentSignature& The signature.
              */
             ComponentSignature &getSignature(const Entity &e);
 
+            /**
+             * @brief Get the Signature object
+             *
+             * @param e The entity.
+             * @return const ComponentSignature& The signature.
+             */
+            const ComponentSignature &getSignature(const Entity &e) const;
+
+            /**
+             * @brief Get the dense index of an entity
+             *
+             * @param e The entity.
+             * @return EntityIndex The index, below getIndexCount
+             * @throws EntityManagerExceptionFindEntityError if the entity is
+             * not found.
+             */
+            EntityIndex getIndex(const Entity &e) const;
+
+            /**
+             * @brief Find the dense index of an entity
+             *
+             * @param e The entity.
+             * @return const EntityIndex* The index, nullptr if the entity is
+             * not found
+             */
+            const EntityIndex *findIndex(const Entity &e) const;
+
+            /**
+             * @brief Get the entity of a dense index in use
+             *
+             * @param index The index, below getIndexCount
+             * @return const Entity& The entity
+             */
+            const Entity &getEntity(EntityIndex index) const
+            {
+                return _index_entities[index];
+            }
+
+            /**
+             * @brief Get the number of indices in use or free
+             *
+             * @return size_t The upper bound of the indices
+             */
+            size_t getIndexCount(void) const;
+
+            /**
+             * @brief Get the bytes held by the dense index: the entity of
+             * every index, the free indices and the component sets
+             *
+             * @return size_t The capacity of the arrays, in bytes
+             */
+            size_t getIndexBytes(void) const;
+
+            /**
+             * @brief Get the set of the indices of the entities having a
+             * component
+             *
+             * @param type The component type.
+             * @return const HierarchicalBitset& The indices
+             */
+            const HierarchicalBitset &getComponentSet(ComponentType type);
+
+            /**
+             * @brief Call f with every entity whose signature contains
+             * signature (every entity if it is empty). The component sets
+             * are intersected word by word, skipping the empty regions, so
+             * a rare combination costs much less than a pass over the
+             * entities. The entities may not change during the call.
+             *
+             * @tparam F void(const Entity &)
+             * @param signature The components to join
+             * @param f The function
+             */
+            template <typename F>
+            void join(const ComponentSignature &signature, F &&f)
+            {
+                std::array<const HierarchicalBitset *, VAZEL_MAX_COMPONENTS>
+                    sets;
+                size_t count = 0;
+
+                __sync();
+                for (ComponentType c = 0; c != VAZEL_MAX_COMPONENTS; c++) {
+                    if (signature.test(c)) {
+                        sets[count++] = &_component_sets[c];
+                    }
+                }
+                if (count == 0) {
+                    sets[count++] = &_alive;
+                }
+                HierarchicalBitset::join(
+                    std::span<const HierarchicalBitset *const>(sets.data(),
+                                                               count),
+                    [&](size_t index) { f(_index_entities[index]); });
+            }
+
             /**
              * @brief Get the Map object
              *
@@ -145,6 +316,14 @@ namespace vazel
              *
              */
             void clear(void);
+
+            /**
+             * @brief Exchange the entities of two EntityManagers in O(1) (they
+             * must use the same memory resource)
+             *
+             * @param other The EntityManager to swap with
+             */
+            void swap(EntityManager &other);
         };
 
     } // namespace ecs
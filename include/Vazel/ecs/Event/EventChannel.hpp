@@ -0,0 +1,171 @@
+/**
+ * include/Vazel/ecs/Event/EventChannel.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ThreadSlot.hpp"
+
+#include <array>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief Type erased base of the EventChannels so the World can flip
+         * all of them at the end of a frame
+         *
+         */
+        class EventChannelBase
+        {
+          public:
+            virtual ~EventChannelBase(void) = default;
+
+            /**
+             * @brief Make the events sent during this frame readable and
+             * forget the events of the previous frame
+             *
+             */
+            virtual void flip(void) = 0;
+
+            /**
+             * @brief Drop every event, sent or readable
+             *
+             */
+            virtual void clear(void) = 0;
+
+            /**
+             * @brief Get the depth of the channel: the readable events and
+             * the events sent since the last flip
+             *
+             * @return size_t The number of events waiting in the channel
+             */
+            virtual size_t pending(void) const = 0;
+        };
+
+        using EventChannelMap =
+            std::unordered_map<const char *,
+                               std::unique_ptr<EventChannelBase>>;
+
+        /**
+         * @brief EventChannel is a double-buffered queue of events of type E.
+         * Events sent during a frame become readable after the next flip (done
+         * by World::updateSystem) and stay readable for the whole next frame.
+         * Every thread writes to its own buffer so systems running on
+         * different threads can send without locking. The buffers keep their
+         * capacity between frames, so sending does not allocate once the
+         * channel is warm.
+         *
+         * @tparam E The type of the events
+         */
+        template <typename E>
+        class EventChannel : public EventChannelBase
+        {
+          private:
+            struct alignas(64) WriteBuffer
+            {
+                std::vector<E> events;
+            };
+
+            std::array<WriteBuffer, VAZEL_MAX_THREADS> _pending;
+            std::vector<E> _readable;
+
+          public:
+            /**
+             * @brief Construct a new Event Channel object
+             *
+             */
+            EventChannel(void) = default;
+
+            /**
+             * @brief Destroy the Event Channel object
+             *
+             */
+            ~EventChannel(void) = default;
+
+            /**
+             * @brief Send an event, it will be readable after the next flip
+             *
+             * @param event The event
+             */
+            void send(const E &event)
+            {
+                _pending[threadSlot()].events.push_back(event);
+            }
+
+            /**
+             * @brief Construct an event in place, it will be readable after
+             * the next flip
+             *
+             * @param args The arguments given to the constructor of E
+             */
+            template <typename... Args>
+            void emplace(Args &&...args)
+            {
+                _pending[threadSlot()].events.emplace_back(
+                    std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Get the events sent during the previous frame, grouped
+             * by sending thread and in the order they were sent by each
+             * thread
+             *
+             * @return std::span<const E> The events
+             */
+            std::span<const E> read(void) const
+            {
+                return std::span<const E>(_readable);
+            }
+
+            void flip(void) override
+            {
+                _readable.clear();
+                for (auto &it : _pending) {
+                    _readable.insert(_readable.end(), it.events.begin(),
+                                     it.events.end());
+                    it.events.clear();
+                }
+            }
+
+            void clear(void) override
+            {
+                _readable.clear();
+                for (auto &it : _pending) {
+                    it.events.clear();
+                }
+            }
+
+            size_t pending(void) const override
+            {
+                size_t count = _readable.size();
+
+                for (const auto &it : _pending) {
+                    count += it.events.size();
+                }
+                return count;
+            }
+        };
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,187 @@
+/**
+ * include/Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief HierarchicalBitset is a set of indices stored as a bitset
+         * with two summary levels: a bit of a block tells that one of its 64
+         * words is not empty, a bit of a region that one of its 64 blocks is
+         * not empty. Iterating or intersecting sets skips the empty 64x64
+         * bit blocks without reading them.
+         *
+         */
+        class HierarchicalBitset
+        {
+          private:
+            std::pmr::vector<uint64_t> _bits;
+            std::pmr::vector<uint64_t> _blocks;
+            std::pmr::vector<uint64_t> _regions;
+
+          public:
+            /**
+             * @brief Construct a new empty Hierarchical Bitset object
+             *
+             * @param resource The memory resource of the levels
+             */
+            HierarchicalBitset(std::pmr::memory_resource *resource =
+                                   std::pmr::get_default_resource());
+
+            /**
+             * @brief Add an index to the set
+             *
+             * @param index The index
+             */
+            void set(size_t index);
+
+            /**
+             * @brief Remove an index from the set
+             *
+             * @param index The index
+             */
+            void reset(size_t index);
+
+            /**
+             * @brief Check if an index is in the set
+             *
+             * @param index The index
+             * @return bool True if it is in the set
+             */
+            bool test(size_t index) const
+            {
+                const size_t w = index / 64;
+
+                return w < _bits.size() && (_bits[w] >> (index % 64)) & 1;
+            }
+
+            /**
+             * @brief Get the number of indices in the set
+             *
+             * @return size_t The number of indices
+             */
+            size_t count(void) const;
+
+            /**
+             * @brief Check if the set is empty, in O(size / 2^18)
+             *
+             * @return bool True if the set is empty
+             */
+            bool empty(void) const;
+
+            /**
+             * @brief Remove every index, the memory is kept
+             *
+             */
+            void clear(void);
+
+            /**
+             * @brief Exchange the content of two sets in O(1)
+             *
+             * @param other The set to swap with
+             */
+            void swap(HierarchicalBitset &other);
+
+            /**
+             * @brief Get the bytes held by the three levels
+             *
+             * @return size_t The capacity of the levels, in bytes
+             */
+            size_t getBytes(void) const;
+
+            /**
+             * @brief Call f with the indices in every set, in increasing
+             * order. The words of the sets are intersected level by level so
+             * a region or a block empty in one set is never read in the
+             * others. The sets may not change during the call.
+             *
+             * @tparam F void(size_t index)
+             * @param sets The sets to intersect (nothing is called if empty)
+             * @param f The function
+             */
+            template <typename F>
+            static void join(std::span<const HierarchicalBitset *const> sets,
+                             F &&f)
+            {
+                if (sets.empty()) {
+                    return;
+                }
+                size_t regions = sets[0]->_regions.size();
+
+                for (const auto *it : sets) {
+                    regions = std::min(regions, it->_regions.size());
+                }
+                for (size_t r = 0; r != regions; r++) {
+                    uint64_t region = ~uint64_t(0);
+
+                    for (const auto *it : sets) {
+                        region &= it->_regions[r];
+                    }
+                    while (region != 0) {
+                        const size_t b = r * 64 + std::countr_zero(region);
+                        uint64_t block = ~uint64_t(0);
+
+                        region &= region - 1;
+                        for (const auto *it : sets) {
+                            block &= it->_blocks[b];
+                        }
+                        while (block != 0) {
+                            const size_t w = b * 64 + std::countr_zero(block);
+                            uint64_t word  = ~uint64_t(0);
+
+                            block &= block - 1;
+                            for (const auto *it : sets) {
+                                word &= it->_bits[w];
+                            }
+                            while (word != 0) {
+                                f(w * 64 + std::countr_zero(word));
+                                word &= word - 1;
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Call f with every index of the set, in increasing order
+             *
+             * @tparam F void(size_t index)
+             * @param f The function
+             */
+            template <typename F>
+            void forEach(F &&f) const
+            {
+                const HierarchicalBitset *self = this;
+
+                join(std::span<const HierarchicalBitset *const>(&self, 1), f);
+            }
+        };
+
+    } // namespace ecs
+} // namespace vazel
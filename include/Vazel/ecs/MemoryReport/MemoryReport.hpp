@@ -0,0 +1,165 @@
+/**
+ * include/Vazel/ecs/MemoryReport/MemoryReport.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/Components/ComponentsManager.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief The memory of one component type (see ComponentPool): the
+         * heap bytes hold the values, the slot bytes the index arrays, pages
+         * or presence bits used to find them.
+         *
+         */
+        struct ComponentMemory
+        {
+            std::string name;
+            ComponentType type  = 0;
+            size_t instances    = 0;
+            size_t instanceSize = 0;
+            size_t payloadBytes = 0;
+            size_t heapBytes    = 0;
+            size_t slotBytes    = 0;
+
+            /**
+             * @brief Get the bytes held for this type
+             *
+             * @return size_t The heap and slot bytes
+             */
+            size_t reservedBytes(void) const;
+
+            /**
+             * @brief Get the bytes held per instance beyond its payload
+             *
+             * @return double The overhead (0 without instance)
+             */
+            double overheadPerInstance(void) const;
+
+            /**
+             * @brief Get the share of the reserved bytes not holding payload
+             *
+             * @return double The fragmentation in [0, 1]
+             */
+            double fragmentation(void) const;
+        };
+
+        /**
+         * @brief The memory of a node based container (unordered map or set)
+         *
+         */
+        struct ContainerMemory
+        {
+            std::string name;
+            size_t elements      = 0;
+            size_t usedBytes     = 0;
+            size_t reservedBytes = 0;
+        };
+
+        /**
+         * @brief The memory of a World (see World::memoryReport). The sizes
+         * of the heap blocks and of the container nodes are estimated from
+         * the usual implementations (glibc malloc, libstdc++ nodes), when the
+         * world allocates from a WorldArena the arena totals are exact.
+         *
+         */
+        struct MemoryReport
+        {
+            std::vector<ComponentMemory> components;
+            ContainerMemory entities;
+            ContainerMemory entityIndex;
+            std::vector<ContainerMemory> systems;
+            size_t arenaAllocated = 0;
+            size_t arenaReserved  = 0;
+
+            /**
+             * @brief Get the estimated bytes held by the world
+             *
+             * @return size_t The components, the entities, their index and
+             * the systems
+             */
+            size_t totalBytes(void) const;
+        };
+
+        /**
+         * @brief Estimate the bytes held by an allocation
+         *
+         * @param size The size requested
+         * @param align The alignment requested
+         * @param resource The resource allocating it
+         * @return size_t The estimated footprint
+         */
+        size_t allocationFootprint(size_t size, size_t align,
+                                   std::pmr::memory_resource *resource);
+
+        /**
+         * @brief Measure a node based container
+         *
+         * @tparam Container An unordered map or set
+         * @param name The name of the container in the report
+         * @param container The container
+         * @return ContainerMemory The memory of the container
+         */
+        template <typename Container>
+        ContainerMemory measureContainer(const std::string &name,
+                                         const Container &container)
+        {
+            using Value = typename Container::value_type;
+            ContainerMemory memory;
+
+            memory.name      = name;
+            memory.elements  = container.size();
+            memory.usedBytes = container.size() * sizeof(Value);
+            // A node holds the value, the next node and the cached hash
+            memory.reservedBytes =
+                container.size() * (sizeof(Value) + 2 * sizeof(void *)) +
+                container.bucket_count() * sizeof(void *);
+            return memory;
+        }
+
+        /**
+         * @brief Measure the components of a ComponentManager by type
+         *
+         * @param cm The ComponentManager
+         * @param resource The memory resource of the ComponentManager
+         * @return std::vector<ComponentMemory> The memory of every registered
+         * type
+         */
+        std::vector<ComponentMemory> measureComponents(
+            const ComponentManager &cm, std::pmr::memory_resource *resource);
+
+        /**
+         * @brief Print a memory report as tables
+         *
+         * @param os The output stream
+         * @param report The report
+         * @return std::ostream& The output stream
+         */
+        std::ostream &operator<<(std::ostream &os, const MemoryReport &report);
+
+    } // namespace ecs
+} // namespace vazel
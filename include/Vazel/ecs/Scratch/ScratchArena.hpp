@@ -0,0 +1,118 @@
+/**
+ * include/Vazel/ecs/Scratch/ScratchArena.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ThreadSlot.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief The default size of the blocks of a ScratchArena
+ *
+ */
+#define VAZEL_SCRATCH_BLOCK_SIZE (64 * 1024)
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief ScratchArena is a linear allocator for temporary memory.
+         * Every thread bumps a pointer in its own blocks, deallocating does
+         * nothing and reset rewinds every thread to the start of its first
+         * block. The blocks are kept between resets so once warm, allocating
+         * never reaches the global heap.
+         * Use it with std::pmr containers:
+         *
+         *     std::pmr::vector<Entity> neighbours(&world.scratch());
+         *
+         */
+        class ScratchArena : public std::pmr::memory_resource
+        {
+          private:
+            struct Block
+            {
+                std::unique_ptr<std::byte[]> data;
+                size_t size;
+            };
+
+            struct alignas(64) Slot
+            {
+                std::vector<Block> blocks;
+                size_t current = 0;
+                size_t offset  = 0;
+                size_t used    = 0;
+            };
+
+            std::array<Slot, VAZEL_MAX_THREADS> _slots;
+            size_t _block_size;
+
+          public:
+            /**
+             * @brief Construct a new Scratch Arena object, the blocks are
+             * allocated on first use
+             *
+             * @param blockSize The size of the blocks
+             */
+            ScratchArena(size_t blockSize = VAZEL_SCRATCH_BLOCK_SIZE);
+
+            /**
+             * @brief Destroy the Scratch Arena object and free its blocks
+             *
+             */
+            ~ScratchArena(void) = default;
+
+            ScratchArena(const ScratchArena &) = delete;
+            ScratchArena &operator=(const ScratchArena &) = delete;
+
+            /**
+             * @brief Rewind every thread, everything allocated becomes
+             * invalid. No thread may allocate during the reset.
+             *
+             */
+            void reset(void);
+
+            /**
+             * @brief Get the number of bytes allocated since the last reset
+             * by every thread
+             *
+             * @return size_t The used bytes
+             */
+            size_t getUsed(void) const;
+
+            /**
+             * @brief Get the number of bytes held in blocks by every thread
+             *
+             * @return size_t The reserved bytes
+             */
+            size_t getReserved(void) const;
+
+          protected:
+            void *do_allocate(size_t bytes, size_t align) override;
+            void do_deallocate(void *ptr, size_t bytes, size_t align) override;
+            bool do_is_equal(const std::pmr::memory_resource &other) const
+                noexcept override;
+        };
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,231 @@
+/**
+ * include/Vazel/ecs/Spatial/SpatialGrid.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+#include "Vazel/ecs/Entity/Entity.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief SpatialGridException is thrown when the SpatialGrid is
+         * misused (unknown entity, invalid cell size...)
+         *
+         */
+        class SpatialGridException : public VException
+        {
+          private:
+            std::string _e = "SpatialGridException: ";
+
+          public:
+            /**
+             * @brief Construct a new Spatial Grid Exception object
+             *
+             * @param e The error message.
+             */
+            SpatialGridException(const std::string &e);
+
+            /**
+             * @brief Get the what object.
+             *
+             * @return const char* The error message.
+             */
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief A 2D position stored in the SpatialGrid
+         *
+         */
+        struct SpatialPoint
+        {
+            float x;
+            float y;
+        };
+
+        using spatialPairCallback =
+            std::function<void(const Entity &, const Entity &)>;
+
+        /**
+         * @brief SpatialGrid is a uniform grid hashed on the cell coordinates.
+         * Only the cells containing entities are allocated so the world does
+         * not need to be bounded. Queries only visit the cells overlapping the
+         * query area.
+         */
+        class SpatialGrid
+        {
+          private:
+            struct Item
+            {
+                Entity entity;
+                SpatialPoint position;
+            };
+
+            struct Tracked
+            {
+                uint64_t cell;
+                SpatialPoint position;
+            };
+
+            float _cell_size;
+            std::unordered_map<uint64_t, std::vector<Item>> _cells;
+            std::unordered_map<Entity, Tracked> _entities;
+
+            /**
+             * @brief Get the cell coordinate of a position on one axis
+             *
+             * @param v The position on the axis
+             * @return int32_t The cell coordinate
+             */
+            int32_t __cellCoord(float v) const;
+
+            /**
+             * @brief Get the key of the cell at the given cell coordinates
+             *
+             */
+            static uint64_t __cellKey(int32_t cx, int32_t cy);
+
+            /**
+             * @brief Remove an entity from the item list of a cell
+             *
+             */
+            void __eraseFromCell(uint64_t cell, const Entity &e);
+
+            /**
+             * @brief Update the stored position of an entity and move it to
+             * another cell if it crossed a cell border
+             *
+             */
+            void __relocate(const Entity &e, Tracked &tracked,
+                            const SpatialPoint &position);
+
+          public:
+            /**
+             * @brief Construct a new Spatial Grid object
+             *
+             * @param cellSize The size of a cell, ideally close to the radius
+             * of the most frequent queries
+             */
+            SpatialGrid(float cellSize);
+
+            /**
+             * @brief Destroy the Spatial Grid object
+             *
+             */
+            ~SpatialGrid(void) = default;
+
+            /**
+             * @brief Get the size of a cell
+             *
+             * @return float The cell size
+             */
+            float getCellSize(void) const;
+
+            /**
+             * @brief Get the number of indexed entities
+             *
+             * @return size_t The number of entities
+             */
+            size_t size(void) const;
+
+            /**
+             * @brief Check if an entity is indexed
+             *
+             * @param e The entity
+             * @return true If the entity is in the grid
+             */
+            bool contains(const Entity &e) const;
+
+            /**
+             * @brief Insert an entity in the grid
+             *
+             * @param e The entity
+             * @param position Its position
+             */
+            void insert(const Entity &e, const SpatialPoint &position);
+
+            /**
+             * @brief Update the position of an indexed entity, the entity only
+             * changes of cell when it crossed a cell border
+             *
+             * @param e The entity
+             * @param position Its new position
+             */
+            void move(const Entity &e, const SpatialPoint &position);
+
+            /**
+             * @brief Remove an entity from the grid
+             *
+             * @param e The entity
+             */
+            void remove(const Entity &e);
+
+            /**
+             * @brief Remove every entity from the grid
+             *
+             */
+            void clear(void);
+
+            /**
+             * @brief Move every indexed entity to its current position
+             *
+             * @param position Gives the current position of an entity
+             */
+            void refresh(
+                const std::function<SpatialPoint(const Entity &)> &position);
+
+            /**
+             * @brief Get the entities within a radius around a position
+             *
+             * @param center The center of the query
+             * @param radius The radius of the query
+             * @param out The entities found are appended to it
+             */
+            void queryRadius(const SpatialPoint &center, float radius,
+                             std::vector<Entity> &out) const;
+
+            /**
+             * @brief Get the entities inside an axis aligned bounding box
+             *
+             * @param min The lower corner of the box
+             * @param max The upper corner of the box
+             * @param out The entities found are appended to it
+             */
+            void queryAABB(const SpatialPoint &min, const SpatialPoint &max,
+                           std::vector<Entity> &out) const;
+
+            /**
+             * @brief Call fn once for every pair of entities closer than
+             * radius to each other
+             *
+             * @param radius The maximum distance between two entities
+             * @param fn The function called with each pair
+             */
+            void forEachPair(float radius, const spatialPairCallback &fn) const;
+        };
+
+    } // namespace ecs
+} // namespace vazel
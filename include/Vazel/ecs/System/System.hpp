@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <functional>
 #include <list>
+#include <memory_resource>
 #include <unordered_set>
 
 /**
@@ -54,16 +55,7 @@ namespace vazel
             ComponentSignature _signature;
             std::string _tag;
             systemUpdate _on_update;
-            std::unordered_set<Entity> _entities;
-
-            /**
-             * @brief Add an entity to the system
-             *
-             * @param entity Entity
-             * @param signature ComponentSignature
-             */
-            void __addEntity(const Entity &entity,
-                             const ComponentSignature &signature);
+            std::pmr::unordered_set<Entity> _entities;
 
           public:
             /**
@@ -80,6 +72,15 @@ namespace vazel
              */
             System(const char *tag);
 
+            /**
+             * @brief Copy a System, its entities are allocated from resource
+             * (used by World::registerSystem)
+             *
+             * @param other The System to copy
+             * @param resource The memory resource of the entities
+             */
+            System(const System &other, std::pmr::memory_resource *resource);
+
             /**
              * @brief Destroy the System object
              *        Remove all entities from the system
@@ -88,14 +89,27 @@ namespace vazel
 
             /**
              * @brief Add all entities from the EntityManager that match the
-             * system signature
+             * system signature (found with EntityManager::join) and remove
+             * the entities that do not match anymore
              *
              * @param emanager EntityManager
              */
             void updateValidEntities(EntityManager &emanager);
 
             /**
-             * @brief Set the system update function
+             * @brief Add or remove one entity after its signature changed
+             *
+             * @param entity The entity
+             * @param signature The signature of the entity
+             */
+            void updateEntity(const Entity &entity,
+                              const ComponentSignature &signature);
+
+            /**
+             * @brief Set the system update function. It is called once per
+             * entity; a component reference it gets is invalidated when a
+             * component of the same type is attached or detached (see
+             * ComponentManager::getComponent), get it again after those.
              *
              * @param updater System update function
              */
@@ -115,6 +129,20 @@ namespace vazel
              */
             const std::string &getTag(void) const;
 
+            /**
+             * @brief Get the number of entities updated by the system
+             *
+             * @return size_t The number of entities
+             */
+            size_t getEntityCount(void) const;
+
+            /**
+             * @brief Get the entities updated by the system
+             *
+             * @return const std::pmr::unordered_set<Entity>& The entities
+             */
+            const std::pmr::unordered_set<Entity> &getEntities(void) const;
+
             /**
              * @brief Add a dependency to the system (Does not update the
              * Entities)
@@ -0,0 +1,54 @@
+/**
+ * include/Vazel/ecs/System/SystemProbe.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/System/System.hpp"
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief SystemProbe is notified by World::updateSystem around the
+         * update of every system, so tools can attribute what they measure
+         * (time, counters...) to each system without touching the systems
+         *
+         */
+        class SystemProbe
+        {
+          public:
+            virtual ~SystemProbe(void) = default;
+
+            /**
+             * @brief Called right before the system is updated
+             *
+             * @param system The system about to be updated
+             */
+            virtual void onSystemBegin(const System &system) = 0;
+
+            /**
+             * @brief Called right after the system was updated
+             *
+             * @param system The system that was updated
+             */
+            virtual void onSystemEnd(const System &system) = 0;
+        };
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,116 @@
+/**
+ * include/Vazel/ecs/System/SystemStats.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/profiling/AllocTracker/AllocTracker.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief The number of updates the rolling statistics are computed on
+ *
+ */
+#define VAZEL_SYSTEM_STATS_SAMPLES 128
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief The statistics of a system, over the last
+         * VAZEL_SYSTEM_STATS_SAMPLES updates for the durations. The
+         * allocations are the total of every update, they are only counted
+         * with VAZEL_ENABLE_ALLOC_TRACKING.
+         *
+         */
+        struct SystemStatsSnapshot
+        {
+            std::string tag;
+            uint64_t calls          = 0;
+            size_t entities         = 0;
+            uint64_t entitiesTotal  = 0;
+            std::chrono::nanoseconds last = {};
+            std::chrono::nanoseconds min  = {};
+            std::chrono::nanoseconds avg  = {};
+            std::chrono::nanoseconds p99  = {};
+            std::chrono::nanoseconds max  = {};
+            profiling::AllocStats allocations;
+        };
+
+        /**
+         * @brief SystemStats records the updates of one system (filled by
+         * World::updateSystem when VAZEL_ENABLE_SYSTEM_STATS is defined).
+         * There is a single writer and readers never block it: every field is
+         * an atomic and the durations are kept in a ring, a snapshot taken
+         * while the system updates may mix two consecutive updates.
+         *
+         */
+        class SystemStats
+        {
+          private:
+            std::atomic<uint64_t> _calls          = 0;
+            std::atomic<uint64_t> _entities       = 0;
+            std::atomic<uint64_t> _entities_total = 0;
+            std::array<std::atomic<int64_t>, VAZEL_SYSTEM_STATS_SAMPLES>
+                _samples = {};
+            profiling::AllocCounter _allocations;
+
+          public:
+            /**
+             * @brief Construct a new System Stats object
+             *
+             */
+            SystemStats(void) = default;
+
+            /**
+             * @brief Destroy the System Stats object
+             *
+             */
+            ~SystemStats(void) = default;
+
+            /**
+             * @brief Record an update (only one thread may record)
+             *
+             * @param elapsed The wall time of the update
+             * @param entities The number of entities updated
+             */
+            void record(std::chrono::nanoseconds elapsed, size_t entities);
+
+            /**
+             * @brief Get the counter of the allocations made by the updates
+             *
+             * @return profiling::AllocCounter& The counter
+             */
+            profiling::AllocCounter &allocations(void);
+
+            /**
+             * @brief Compute the statistics, from any thread
+             *
+             * @param tag The tag of the system
+             * @return SystemStatsSnapshot The statistics
+             */
+            SystemStatsSnapshot snapshot(const std::string &tag) const;
+        };
+
+    } // namespace ecs
+} // namespace vazel
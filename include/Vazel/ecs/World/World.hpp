@@ -19,9 +19,18 @@
 
 #include "Vazel/ecs/Components/ComponentsManager.hpp"
 #include "Vazel/ecs/Entity/EntityManager.hpp"
+#include "Vazel/ecs/Event/EventChannel.hpp"
+#include "Vazel/ecs/MemoryReport/MemoryReport.hpp"
+#include "Vazel/ecs/Scratch/ScratchArena.hpp"
+#include "Vazel/ecs/Spatial/SpatialGrid.hpp"
 #include "Vazel/ecs/System/System.hpp"
+#include "Vazel/ecs/System/SystemProbe.hpp"
+#include "Vazel/ecs/System/SystemStats.hpp"
+#include "Vazel/ecs/WorldArena/WorldArena.hpp"
+#include "Vazel/ecs/WorldMetrics/WorldMetrics.hpp"
 
 #include <list>
+#include <utility>
 
 namespace vazel
 {
@@ -54,6 +63,32 @@ namespace vazel
             const char *what() const throw() override;
         };
 
+        /**
+         * @brief The structural changes made to a World since it was
+         * constructed
+         *
+         */
+        struct StructuralChanges
+        {
+            uint64_t entitiesCreated    = 0;
+            uint64_t entitiesRemoved    = 0;
+            uint64_t componentsAttached = 0;
+            uint64_t componentsDetached = 0;
+
+            /**
+             * @brief Get the changes made between two readings
+             *
+             * @param other The earlier reading
+             * @return StructuralChanges The difference
+             */
+            StructuralChanges operator-(const StructuralChanges &other) const;
+        };
+
+        using spatialPositionGetter =
+            std::function<SpatialPoint(ComponentManager &, const Entity &)>;
+
+        class WorldReaper;
+
         /**
          * @brief The World class
          *
@@ -61,9 +96,44 @@ namespace vazel
         class World
         {
           private:
+            std::pmr::memory_resource *_resource;
+            WorldArena *_arena = nullptr;
+
             std::vector<std::unique_ptr<System>> _systems;
-            ComponentManager _componentManager;
             EntityManager _entityManager;
+            ComponentManager _componentManager;
+
+            EventChannelMap _events;
+
+            std::unique_ptr<SpatialGrid> _spatialIndex;
+            ComponentType _spatialComponent;
+            spatialPositionGetter _spatialPosition;
+
+            double _deltaTime = 0;
+
+            SystemProbe *_probe = nullptr;
+
+            WorldMetrics *_metrics = nullptr;
+
+            StructuralChanges _changes;
+
+            ScratchArena _scratch;
+
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+            profiling::AllocCounter _frameAllocations;
+#endif
+
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+            // Same order as _systems
+            std::vector<std::unique_ptr<SystemStats>> _systemStats;
+#endif
+
+            /**
+             * @brief Add or remove an entity from the systems after its
+             * signature changed
+             *
+             */
+            void __updateSystemsEntity(const Entity &e);
 
             std::vector<std::unique_ptr<System>>::iterator
                 __getSystemIteratorFromTag(const char *tag)
@@ -78,8 +148,20 @@ namespace vazel
             /**
              * @brief Construct a new World object
              *
+             * @param resource The memory resource of the components, of the
+             * entity map and of the entities of the systems
+             */
+            World(std::pmr::memory_resource *resource =
+                      std::pmr::get_default_resource());
+
+            /**
+             * @brief Construct a new World object allocating from an arena.
+             * The arena must outlive the world and only serve this world,
+             * clearWorld releases it.
+             *
+             * @param arena The arena of the world
              */
-            World(void) = default;
+            World(WorldArena &arena);
 
             /**
              * @brief Destroy the World object
@@ -157,18 +239,59 @@ namespace vazel
 
             /**
              * @brief Update the systems with System::update for each system
+             * then flip the event channels and reset the scratch arena
              */
             void updateSystem(void);
 
+            /**
+             * @brief Set the probe notified around the update of every system
+             * (it is kept by clearWorld)
+             *
+             * @param probe The probe (nullptr to remove it)
+             */
+            void setSystemProbe(SystemProbe *probe);
+
+            /**
+             * @brief Get the probe notified around the update of every system
+             *
+             * @return SystemProbe* The probe (nullptr if there is none)
+             */
+            SystemProbe *getSystemProbe(void) const;
+
+            /**
+             * @brief Publish the counters of the world at every updateSystem
+             * (it is kept by clearWorld and not exchanged by swap)
+             *
+             * @param metrics The metrics (nullptr to stop publishing)
+             */
+            void setMetrics(WorldMetrics *metrics);
+
+            /**
+             * @brief Get the number of entities alive
+             *
+             * @return size_t The number of entities
+             */
+            size_t getEntityCount(void) const;
+
+            /**
+             * @brief Get the structural changes made to this World object
+             * (they are not reset by clearWorld nor exchanged by swap)
+             *
+             * @return const StructuralChanges& The changes
+             */
+            const StructuralChanges &getStructuralChanges(void) const;
+
             /**
              * @brief Register a Component to the ComponentManager
              *
              * @tparam T The type of the component.
+             * @param storage How the values are stored (see ComponentStorage)
              */
             template <typename T>
-            const ComponentType registerComponent(void)
+            const ComponentType registerComponent(
+                ComponentStorage storage = ComponentStorage::Sparse)
             {
-                return _componentManager.registerComponent<T>();
+                return _componentManager.registerComponent<T>(storage);
             }
 
             /**
@@ -182,10 +305,19 @@ namespace vazel
             template <typename T>
             void attachComponent(Entity &e, T &data)
             {
+                VAZEL_ALLOC_SCOPE("World::attachComponent");
+
                 _componentManager.attachComponent<T>(e, data);
-                _entityManager.getSignature(e).set(
-                    _componentManager.getComponentType<T>(), true);
-                updateSystemsEntities();
+                const ComponentType type =
+                    _componentManager.getComponentType<T>();
+
+                _changes.componentsAttached++;
+                _entityManager.setComponent(e, type, true);
+                if (_spatialIndex != nullptr && type == _spatialComponent) {
+                    _spatialIndex->insert(
+                        e, _spatialPosition(_componentManager, e));
+                }
+                __updateSystemsEntity(e);
             }
 
             /**
@@ -213,12 +345,31 @@ namespace vazel
             template <typename T>
             void detachComponent(Entity &e)
             {
+                VAZEL_ALLOC_SCOPE("World::detachComponent");
+
                 _componentManager.detachComponent<T>(e);
-                _entityManager.getSignature(e).set(
-                    _componentManager.getComponentType<T>(), false);
-                updateSystemsEntities();
+                const ComponentType type =
+                    _componentManager.getComponentType<T>();
+
+                _changes.componentsDetached++;
+                _entityManager.setComponent(e, type, false);
+                if (_spatialIndex != nullptr && type == _spatialComponent &&
+                    _spatialIndex->contains(e)) {
+                    _spatialIndex->remove(e);
+                }
+                __updateSystemsEntity(e);
             }
 
+            /**
+             * @brief Get the component T of an entity. The reference is valid
+             * until a T is attached to or detached from any entity (or an
+             * entity having one is removed), see
+             * ComponentManager::getComponent. Get it again after those.
+             *
+             * @tparam T The component type
+             * @param e The entity
+             * @return T& The component
+             */
             template <typename T>
             T &getComponent(Entity &e)
             {
@@ -226,10 +377,204 @@ namespace vazel
             }
 
             /**
-             * @brief Clear completely the World instance
+             * @brief Call f with every entity having the components Ts and
+             * with its components, driven by the smallest of their pools (see
+             * ComponentManager::join). The entities and their components may
+             * not be added or removed during the call.
+             *
+             *     world.join<Position, Velocity>(
+             *         [](const Entity &e, Position &p, Velocity &v) {...});
+             *
+             * @tparam Ts The components to join
+             * @param f void(const Entity &, Ts &...)
+             */
+            template <typename... Ts, typename F>
+            void join(F &&f)
+            {
+                _componentManager.join<Ts...>(std::forward<F>(f));
+            }
+
+            /**
+             * @brief Get the channel of the events of type E, it is created on
+             * the first call. Events sent during a frame are readable during
+             * the next one (the channels are flipped at the end of
+             * updateSystem).
+             * Create the channels before sending from several threads, the
+             * creation itself is not thread safe.
+             *
+             * @tparam E The type of the events
+             * @return EventChannel<E>& The channel
+             */
+            template <typename E>
+            EventChannel<E> &events(void)
+            {
+                auto &channel = _events[typeid(E).name()];
+
+                if (channel == nullptr) {
+                    channel = std::make_unique<EventChannel<E>>();
+                }
+                return static_cast<EventChannel<E> &>(*channel);
+            }
+
+            /**
+             * @brief Index the entities owning the position component T in a
+             * SpatialGrid. The index follows attachComponent, detachComponent
+             * and removeEntity, and the positions are refreshed at the
+             * beginning of updateSystem (or with updateSpatialIndex).
+             *
+             * @tparam T The position component
+             * @param cellSize The size of a cell of the grid
+             * @param position Gives the position stored in a T (T::x and T::y
+             * by default)
+             */
+            template <typename T>
+            void enableSpatialIndex(
+                float cellSize,
+                std::function<SpatialPoint(const T &)> position =
+                    [](const T &c) {
+                        return SpatialPoint { c.x, c.y };
+                    })
+            {
+                auto grid = std::make_unique<SpatialGrid>(cellSize);
+
+                _spatialComponent = registerComponent<T>();
+                _spatialPosition  = [position](ComponentManager &cm,
+                                              const Entity &e) {
+                    return position(cm.getComponent<T>(e));
+                };
+                for (const auto &it : _entityManager.getMap()) {
+                    if (it.second.signature.test(_spatialComponent)) {
+                        grid->insert(it.first, _spatialPosition(
+                                                   _componentManager,
+                                                   it.first));
+                    }
+                }
+                _spatialIndex = std::move(grid);
+            }
+
+            /**
+             * @brief Stop indexing the entities positions
+             *
+             */
+            void disableSpatialIndex(void);
+
+            /**
+             * @brief Check if the spatial index is enabled
+             *
+             * @return true If enableSpatialIndex was called
+             */
+            bool hasSpatialIndex(void) const;
+
+            /**
+             * @brief Get the spatial index to run radius, AABB or neighbour
+             * pair queries
+             *
+             * @return const SpatialGrid& The spatial index
+             * @throws WorldException if the spatial index is not enabled
+             */
+            const SpatialGrid &getSpatialIndex(void) const;
+
+            /**
+             * @brief Move the indexed entities to their current position, only
+             * the entities that changed of cell are moved in the grid
+             *
+             */
+            void updateSpatialIndex(void);
+
+            /**
+             * @brief Get the scratch arena of the world, for the temporary
+             * allocations of the systems. What is allocated from it is valid
+             * until the end of the current updateSystem.
+             *
+             * @return ScratchArena& The scratch arena
+             */
+            ScratchArena &scratch(void);
+
+            /**
+             * @brief Get the statistics of the systems, recorded by
+             * updateSystem when VAZEL_ENABLE_SYSTEM_STATS is defined (empty
+             * otherwise). It may be called from any thread, as long as no
+             * system is registered or removed meanwhile.
+             *
+             * @return std::vector<SystemStatsSnapshot> The statistics, in the
+             * update order of the systems
+             */
+            std::vector<SystemStatsSnapshot> systemStats(void) const;
+
+            /**
+             * @brief Get the allocations made by the thread running the last
+             * updateSystem, during it (zero without
+             * VAZEL_ENABLE_ALLOC_TRACKING). In a steady state it should be
+             * zero.
+             *
+             * @return profiling::AllocStats The allocations
+             */
+            profiling::AllocStats getFrameAllocations(void) const;
+
+            /**
+             * @brief Measure the memory of the components by type, of the
+             * entities and of the systems
+             *
+             * @return MemoryReport The report (print it with operator<<)
+             */
+            MemoryReport memoryReport(void) const;
+
+            /**
+             * @brief Set the simulated time of the current update (done by
+             * App::run before every update)
+             *
+             * @param deltaTime The delta time in seconds
+             */
+            void setDeltaTime(double deltaTime);
+
+            /**
+             * @brief Get the simulated time of the current update, systems
+             * capturing the world read it to scale their work
+             *
+             * @return double The delta time in seconds
+             */
+            double getDeltaTime(void) const;
+
+            /**
+             * @brief Get the memory resource of the world
+             *
+             * @return std::pmr::memory_resource* The memory resource
+             */
+            std::pmr::memory_resource *getMemoryResource(void) const;
+
+            /**
+             * @brief Clear completely the World instance, the arena of the
+             * world (if any) is released in one operation
              *
              */
             void clearWorld(void);
+
+            /**
+             * @brief Clear the World in O(1): its content is moved to a new
+             * world destroyed by the shared WorldReaper in the background.
+             * The memory resource must accept deallocations from the reaper
+             * thread, a world using an arena is cleared synchronously since
+             * releasing the arena is already cheap.
+             *
+             */
+            void clearWorldAsync(void);
+
+            /**
+             * @brief Clear the World in O(1): its content is moved to a new
+             * world destroyed by reaper in the background
+             *
+             * @param reaper The reaper destroying the old content
+             */
+            void clearWorldAsync(WorldReaper &reaper);
+
+            /**
+             * @brief Exchange the content of two Worlds in O(1), nothing is
+             * copied (the system probe is not exchanged). Both worlds must use
+             * the same memory resource.
+             *
+             * @param other The World to swap with
+             */
+            void swap(World &other);
         };
 
     } // namespace ecs
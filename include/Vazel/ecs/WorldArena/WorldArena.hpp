@@ -0,0 +1,142 @@
+/**
+ * include/Vazel/ecs/WorldArena/WorldArena.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief WorldArena is the memory resource of a single World: a pool
+         * of fixed size blocks (so attaching and detaching components reuses
+         * the memory) taken from large chunks of the upstream resource.
+         * It accounts the memory of the world and can bound it, an allocation
+         * that would take more than the limit from upstream throws
+         * std::bad_alloc.
+         * It is not thread safe, a World is only updated by one thread at a
+         * time.
+         *
+         */
+        class WorldArena : public std::pmr::memory_resource
+        {
+          private:
+            /**
+             * @brief Counts and bounds what the pool takes from upstream
+             *
+             */
+            class Upstream : public std::pmr::memory_resource
+            {
+              public:
+                std::pmr::memory_resource *parent;
+                size_t reserved = 0;
+                size_t peak     = 0;
+                size_t limit    = 0;
+
+                Upstream(std::pmr::memory_resource *resource);
+
+              protected:
+                void *do_allocate(size_t bytes, size_t align) override;
+                void do_deallocate(void *ptr, size_t bytes,
+                                   size_t align) override;
+                bool do_is_equal(
+                    const std::pmr::memory_resource &other) const
+                    noexcept override;
+            };
+
+            Upstream _upstream;
+            std::pmr::unsynchronized_pool_resource _pool;
+            size_t _allocated = 0;
+
+          public:
+            /**
+             * @brief Construct a new World Arena object
+             *
+             * @param limit The maximum number of bytes taken from upstream (0
+             * for no limit)
+             * @param upstream The resource the chunks are taken from
+             */
+            WorldArena(size_t limit = 0, std::pmr::memory_resource *upstream =
+                                             std::pmr::new_delete_resource());
+
+            /**
+             * @brief Destroy the World Arena object and free its chunks, the
+             * World using it must be destroyed first
+             *
+             */
+            ~WorldArena(void) = default;
+
+            WorldArena(const WorldArena &) = delete;
+            WorldArena &operator=(const WorldArena &) = delete;
+
+            /**
+             * @brief Give every chunk back to upstream at once. Everything
+             * allocated from the arena becomes invalid (World::clearWorld
+             * calls it once the world is empty)
+             *
+             */
+            void release(void);
+
+            /**
+             * @brief Get the number of bytes in use by the world
+             *
+             * @return size_t The allocated bytes
+             */
+            size_t getAllocated(void) const;
+
+            /**
+             * @brief Get the number of bytes taken from upstream
+             *
+             * @return size_t The reserved bytes
+             */
+            size_t getReserved(void) const;
+
+            /**
+             * @brief Get the highest number of bytes taken from upstream
+             *
+             * @return size_t The peak of the reserved bytes
+             */
+            size_t getPeak(void) const;
+
+            /**
+             * @brief Get the maximum number of bytes taken from upstream
+             *
+             * @return size_t The limit (0 if there is none)
+             */
+            size_t getLimit(void) const;
+
+            /**
+             * @brief Set the maximum number of bytes taken from upstream, it
+             * only applies to the next allocations
+             *
+             * @param limit The limit (0 for no limit)
+             */
+            void setLimit(size_t limit);
+
+          protected:
+            void *do_allocate(size_t bytes, size_t align) override;
+            void do_deallocate(void *ptr, size_t bytes, size_t align) override;
+            bool do_is_equal(const std::pmr::memory_resource &other) const
+                noexcept override;
+        };
+
+    } // namespace ecs
+} // namespace vazel
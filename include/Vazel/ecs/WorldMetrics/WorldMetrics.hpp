@@ -0,0 +1,106 @@
+/**
+ * include/Vazel/ecs/WorldMetrics/WorldMetrics.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/Components/ComponentsManager.hpp"
+#include "Vazel/ecs/Event/EventChannel.hpp"
+#include "Vazel/ecs/System/System.hpp"
+#include "Vazel/profiling/Metrics/Metrics.hpp"
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        /**
+         * @brief WorldMetrics publishes the counters of a World in a Metrics
+         * registry, labelled with the name of the world:
+         * vazel_entities, vazel_components (by component),
+         * vazel_events_pending (by event channel), and
+         * vazel_system_seconds_total, vazel_system_updates_total and
+         * vazel_system_entities (by system).
+         * Set it with World::setMetrics, it is updated by updateSystem. The
+         * metrics of a new system or component are declared at its first
+         * update (or publish), the other updates do not lock.
+         *
+         */
+        class WorldMetrics
+        {
+          private:
+            struct SystemMetrics
+            {
+                const System *system        = nullptr;
+                profiling::Counter *time    = nullptr;
+                profiling::Counter *updates = nullptr;
+                profiling::Gauge *entities  = nullptr;
+            };
+
+            struct ComponentMetrics
+            {
+                const char *name        = nullptr;
+                profiling::Gauge *count = nullptr;
+            };
+
+            profiling::Metrics &_metrics;
+            const std::string _labels;
+            profiling::Gauge &_entities;
+            std::array<ComponentMetrics, VAZEL_MAX_COMPONENTS> _components;
+            std::unordered_map<const char *, profiling::Gauge *> _channels;
+            std::vector<SystemMetrics> _systems;
+
+          public:
+            /**
+             * @brief Construct a new World Metrics object
+             *
+             * @param world The name of the world (the world label)
+             * @param metrics The registry of the metrics
+             */
+            WorldMetrics(const std::string &world = "main",
+                         profiling::Metrics &metrics =
+                             profiling::Metrics::getInstance());
+
+            /**
+             * @brief Count an update of a system
+             *
+             * @param index The index of the system in the world
+             * @param system The system
+             * @param elapsed The duration of the update
+             */
+            void recordSystem(size_t index, const System &system,
+                              std::chrono::nanoseconds elapsed);
+
+            /**
+             * @brief Set the number of entities, of components and the depth
+             * of the event channels
+             *
+             * @param components The components of the world
+             * @param entities The number of entities of the world
+             * @param events The event channels of the world
+             */
+            void publish(const ComponentManager &components, size_t entities,
+                         const EventChannelMap &events);
+        };
+
+    } // namespace ecs
+} // namespace vazel
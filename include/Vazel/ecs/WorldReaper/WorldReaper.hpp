@@ -0,0 +1,98 @@
+/**
+ * include/Vazel/ecs/WorldReaper/WorldReaper.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vazel
+{
+    namespace ecs
+    {
+        class World;
+
+        /**
+         * @brief WorldReaper destroys detached worlds on a low priority
+         * background thread, so the frame loop does not pay for freeing
+         * every component, entity and system of a large world.
+         * The destructors of the components and of the captures of the
+         * systems run on the reaper thread.
+         *
+         */
+        class WorldReaper
+        {
+          private:
+            std::mutex _mut;
+            std::condition_variable _cv_work;
+            std::condition_variable _cv_done;
+            std::vector<std::unique_ptr<World>> _queue;
+            size_t _pending = 0;
+            bool _stopping  = false;
+            std::thread _thread;
+
+            void __reaperLoop(void);
+
+          public:
+            /**
+             * @brief Construct a new World Reaper object and start its thread
+             *
+             */
+            WorldReaper(void);
+
+            /**
+             * @brief Destroy the queued worlds then stop the thread
+             *
+             */
+            ~WorldReaper(void);
+
+            WorldReaper(const WorldReaper &) = delete;
+            WorldReaper &operator=(const WorldReaper &) = delete;
+
+            /**
+             * @brief Get the reaper used by World::clearWorldAsync
+             *
+             * @return WorldReaper& The shared reaper
+             */
+            static WorldReaper &getInstance(void);
+
+            /**
+             * @brief Queue a world for destruction
+             *
+             * @param world The world to destroy
+             */
+            void reap(std::unique_ptr<World> world);
+
+            /**
+             * @brief Block until every queued world is destroyed
+             *
+             */
+            void wait(void);
+
+            /**
+             * @brief Get the number of worlds not destroyed yet
+             *
+             * @return size_t The number of worlds
+             */
+            size_t pending(void);
+        };
+
+    } // namespace ecs
+} // namespace vazel
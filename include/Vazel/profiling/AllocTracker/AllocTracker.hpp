@@ -0,0 +1,180 @@
+/**
+ * include/Vazel/profiling/AllocTracker/AllocTracker.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define VAZEL_ALLOC_CONCAT_(a, b) a##b
+#define VAZEL_ALLOC_CONCAT(a, b) VAZEL_ALLOC_CONCAT_(a, b)
+
+/**
+ * @brief VAZEL_ALLOC_SCOPE attributes the allocations of the enclosing scope
+ * to a named site (see allocSites) when the library is built with
+ * VAZEL_ENABLE_ALLOC_TRACKING, it compiles to nothing otherwise. The name
+ * must be a string literal.
+ *
+ */
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+#define VAZEL_ALLOC_SCOPE(name)                                              \
+    static ::vazel::profiling::AllocSite VAZEL_ALLOC_CONCAT(                 \
+        __vazel_alloc_site_, __LINE__)(name);                                \
+    ::vazel::profiling::AllocScope VAZEL_ALLOC_CONCAT(__vazel_alloc_scope_,  \
+                                                      __LINE__)(             \
+        VAZEL_ALLOC_CONCAT(__vazel_alloc_site_, __LINE__).counter)
+#else
+#define VAZEL_ALLOC_SCOPE(name) ((void)0)
+#endif
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        /**
+         * @brief A number of allocations through operator new
+         *
+         */
+        struct AllocStats
+        {
+            uint64_t allocations = 0;
+            uint64_t bytes       = 0;
+
+            AllocStats &operator+=(const AllocStats &other);
+        };
+
+        /**
+         * @brief AllocCounter counts the allocations made in the AllocScopes
+         * using it, from any thread
+         *
+         */
+        class AllocCounter
+        {
+          private:
+            std::atomic<uint64_t> _allocations = 0;
+            std::atomic<uint64_t> _bytes       = 0;
+
+          public:
+            /**
+             * @brief Count an allocation
+             *
+             * @param bytes The size of the allocation
+             */
+            void add(size_t bytes);
+
+            /**
+             * @brief Get the allocations counted since the last reset
+             *
+             * @return AllocStats The allocations
+             */
+            AllocStats get(void) const;
+
+            /**
+             * @brief Restart counting from zero
+             *
+             */
+            void reset(void);
+        };
+
+        /**
+         * @brief A named AllocCounter, registered for the lifetime of the
+         * program (use VAZEL_ALLOC_SCOPE)
+         *
+         */
+        struct AllocSite
+        {
+            const char *name;
+            AllocCounter counter;
+            AllocSite *next;
+
+            AllocSite(const char *siteName);
+        };
+
+        /**
+         * @brief AllocScope counts the allocations of the calling thread in a
+         * counter while it lives. Scopes nest: an allocation is counted by
+         * every enclosing scope of the thread.
+         *
+         */
+        class AllocScope
+        {
+          private:
+            AllocCounter &_counter;
+            AllocScope *_parent;
+
+          public:
+            /**
+             * @brief Begin counting
+             *
+             * @param counter The counter of the scope
+             */
+            AllocScope(AllocCounter &counter);
+
+            /**
+             * @brief Stop counting
+             *
+             */
+            ~AllocScope(void);
+
+            AllocScope(const AllocScope &) = delete;
+            AllocScope &operator=(const AllocScope &) = delete;
+
+            /**
+             * @brief Count an allocation in the scopes of the calling thread
+             * (called by operator new)
+             *
+             * @param bytes The size of the allocation
+             */
+            static void record(size_t bytes);
+        };
+
+        /**
+         * @brief Check if operator new is replaced to count the allocations
+         *
+         * @return true The library is built with VAZEL_ENABLE_ALLOC_TRACKING
+         * @return false The counters stay at zero
+         */
+        bool allocTrackingEnabled(void);
+
+        /**
+         * @brief Get the allocations of the process since it started
+         *
+         * @return AllocStats The allocations of every thread
+         */
+        AllocStats allocTotal(void);
+
+        /**
+         * @brief Get the allocations of the VAZEL_ALLOC_SCOPE sites, the
+         * sites sharing a name (the instances of a template) are summed
+         *
+         * @return std::vector<std::pair<std::string, AllocStats>> The sites,
+         * by name
+         */
+        std::vector<std::pair<std::string, AllocStats>> allocSites(void);
+
+        /**
+         * @brief Restart the counters of every site from zero
+         *
+         */
+        void resetAllocSites(void);
+
+    } // namespace profiling
+} // namespace vazel
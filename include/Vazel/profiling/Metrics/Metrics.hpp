@@ -0,0 +1,383 @@
+/**
+ * include/Vazel/profiling/Metrics/Metrics.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ThreadSlot.hpp"
+#include "Vazel/VException.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The number of finite buckets of a Histogram. The upper bound of
+ * bucket i is 2^(i + 14) ns, from 16.4 us to 1.07 s.
+ *
+ */
+#define VAZEL_METRICS_HISTOGRAM_BUCKETS 17
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        /**
+         * @brief MetricsException is thrown when a metric is declared twice
+         * with different kinds, has an invalid name, or when the metrics
+         * cannot be exported
+         *
+         */
+        class MetricsException : public VException
+        {
+          private:
+            std::string _e = "MetricsException: ";
+
+          public:
+            MetricsException(const std::string &e);
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief The Prometheus type of a metric
+         *
+         */
+        enum class MetricKind
+        {
+            Counter,
+            Gauge,
+            Histogram
+        };
+
+        /**
+         * @brief Metric is a named sample of the engine, with an optional set
+         * of labels in the Prometheus syntax (system="move")
+         *
+         */
+        class Metric
+        {
+          private:
+            const std::string _name;
+            const std::string _help;
+            const std::string _labels;
+
+          protected:
+            /**
+             * @brief Write a sample line "name{labels} value"
+             *
+             * @param out The stream to write to
+             * @param suffix Appended to the name (_bucket, _sum...)
+             * @param extra A label added to the labels (le="0.5")
+             * @param value The value of the sample
+             */
+            void writeSample(std::ostream &out, const char *suffix,
+                             const std::string &extra, double value) const;
+
+          public:
+            Metric(const std::string &name, const std::string &help,
+                   const std::string &labels);
+            virtual ~Metric(void) = default;
+
+            Metric(const Metric &) = delete;
+            Metric &operator=(const Metric &) = delete;
+
+            const std::string &getName(void) const;
+            const std::string &getHelp(void) const;
+            const std::string &getLabels(void) const;
+
+            /**
+             * @brief Get the Prometheus type of the metric
+             *
+             * @return MetricKind The type
+             */
+            virtual MetricKind getKind(void) const = 0;
+
+            /**
+             * @brief Write the samples of the metric in the Prometheus text
+             * format (without the HELP and TYPE lines)
+             *
+             * @param out The stream to write to
+             */
+            virtual void write(std::ostream &out) const = 0;
+        };
+
+        /**
+         * @brief Counter is a sum kept in one cell per thread slot: a thread
+         * only writes its own cell (no lock, no shared cache line) and the
+         * cells are added when the counter is read.
+         *
+         */
+        class Counter : public Metric
+        {
+          private:
+            struct alignas(64) Cell
+            {
+                std::atomic<int64_t> value = 0;
+            };
+
+            std::array<Cell, VAZEL_MAX_THREADS> _cells;
+            const double _scale;
+
+          public:
+            /**
+             * @brief Construct a new Counter object
+             *
+             * @param name The name of the metric
+             * @param help The description of the metric
+             * @param labels The labels (system="move"), may be empty
+             * @param scale Applied to the sum when exported (1e-9 to export
+             * nanoseconds as seconds)
+             */
+            Counter(const std::string &name, const std::string &help,
+                    const std::string &labels, double scale = 1);
+
+            /**
+             * @brief Add to the counter from the calling thread
+             *
+             * @param n The amount to add
+             */
+            void add(int64_t n = 1)
+            {
+                // Only the owner of the slot writes its cell
+                std::atomic<int64_t> &cell = _cells[threadSlot()].value;
+
+                cell.store(cell.load(std::memory_order_relaxed) + n,
+                           std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Get the sum of the cells (not scaled)
+             *
+             * @return int64_t The value of the counter
+             */
+            int64_t getValue(void) const;
+
+            MetricKind getKind(void) const override;
+            void write(std::ostream &out) const override;
+        };
+
+        /**
+         * @brief Gauge is a value set by its owner (the number of entities,
+         * the depth of a queue...)
+         *
+         */
+        class Gauge : public Metric
+        {
+          private:
+            std::atomic<double> _value = 0;
+
+          public:
+            Gauge(const std::string &name, const std::string &help,
+                  const std::string &labels);
+
+            /**
+             * @brief Set the value of the gauge
+             *
+             * @param value The new value
+             */
+            void set(double value)
+            {
+                _value.store(value, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Get the value of the gauge
+             *
+             * @return double The value
+             */
+            double getValue(void) const;
+
+            MetricKind getKind(void) const override;
+            void write(std::ostream &out) const override;
+        };
+
+        /**
+         * @brief Histogram counts durations in power of two buckets, one set
+         * of buckets per thread slot. It is exported as a Prometheus
+         * histogram in seconds, the percentiles are computed by the scraper
+         * (histogram_quantile) or with getQuantile.
+         *
+         */
+        class Histogram : public Metric
+        {
+          private:
+            struct alignas(64) Lane
+            {
+                std::array<std::atomic<uint64_t>,
+                           VAZEL_METRICS_HISTOGRAM_BUCKETS + 1>
+                    buckets = {};
+                std::atomic<uint64_t> sum = 0;
+            };
+
+            using Buckets =
+                std::array<uint64_t, VAZEL_METRICS_HISTOGRAM_BUCKETS + 1>;
+
+            std::array<Lane, VAZEL_MAX_THREADS> _lanes;
+
+            /**
+             * @brief Add the buckets of the lanes, the last one counts the
+             * durations above every bound
+             *
+             */
+            Buckets __getBuckets(void) const;
+
+          public:
+            Histogram(const std::string &name, const std::string &help,
+                      const std::string &labels);
+
+            /**
+             * @brief Count a duration from the calling thread
+             *
+             * @param duration The duration
+             */
+            void observe(std::chrono::nanoseconds duration);
+
+            /**
+             * @brief Get the upper bound of a bucket
+             *
+             * @param bucket The bucket, in
+             * [0, VAZEL_METRICS_HISTOGRAM_BUCKETS)
+             * @return std::chrono::nanoseconds The upper bound
+             */
+            static std::chrono::nanoseconds getBound(size_t bucket);
+
+            /**
+             * @brief Get the number of durations counted
+             *
+             * @return uint64_t The count
+             */
+            uint64_t getCount(void) const;
+
+            /**
+             * @brief Estimate a quantile: the upper bound of the bucket that
+             * holds it
+             *
+             * @param quantile The quantile, in [0, 1]
+             * @return std::chrono::nanoseconds The estimate (zero without
+             * durations, the last bound if it is above)
+             */
+            std::chrono::nanoseconds getQuantile(double quantile) const;
+
+            MetricKind getKind(void) const override;
+            void write(std::ostream &out) const override;
+        };
+
+        /**
+         * @brief Metrics is a registry of metrics exported in the Prometheus
+         * text format. Declaring a metric locks the registry, updating it does
+         * not: declare them once and keep the references (they live as long
+         * as the registry).
+         *
+         */
+        class Metrics
+        {
+          private:
+            mutable std::mutex _mutex;
+            std::vector<std::unique_ptr<Metric>> _metrics;
+
+            /**
+             * @brief Find a declared metric, or check the name of a new one
+             *
+             * @return Metric* The metric (nullptr if it is not declared)
+             * @throw MetricsException The name is invalid, or declared with
+             * another kind
+             */
+            Metric *__find(const std::string &name, const std::string &labels,
+                           MetricKind kind) const;
+
+          public:
+            Metrics(void) = default;
+            ~Metrics(void) = default;
+
+            Metrics(const Metrics &) = delete;
+            Metrics &operator=(const Metrics &) = delete;
+
+            /**
+             * @brief Get the process registry, used by the engine
+             *
+             * @return Metrics& The registry
+             */
+            static Metrics &getInstance(void);
+
+            /**
+             * @brief Get a counter, it is declared on the first call
+             *
+             * @param name The name of the metric ([a-zA-Z_:][a-zA-Z0-9_:]*)
+             * @param help The description of the metric
+             * @param labels The labels (see metricLabel), may be empty
+             * @param scale Applied to the value when exported
+             * @return Counter& The counter
+             * @throw MetricsException See __find
+             */
+            Counter &counter(const std::string &name, const std::string &help,
+                             const std::string &labels = "",
+                             double scale              = 1);
+
+            /**
+             * @brief Get a gauge, it is declared on the first call
+             *
+             * @return Gauge& The gauge
+             * @throw MetricsException See __find
+             */
+            Gauge &gauge(const std::string &name, const std::string &help,
+                         const std::string &labels = "");
+
+            /**
+             * @brief Get a histogram, it is declared on the first call
+             *
+             * @return Histogram& The histogram
+             * @throw MetricsException See __find
+             */
+            Histogram &histogram(const std::string &name,
+                                 const std::string &help,
+                                 const std::string &labels = "");
+
+            /**
+             * @brief Get the number of declared metrics
+             *
+             * @return size_t The number of metrics
+             */
+            size_t size(void) const;
+
+            /**
+             * @brief Write every metric in the Prometheus text format
+             * (version 0.0.4). It can run on any thread while the metrics are
+             * updated.
+             *
+             * @param out The stream to write to
+             */
+            void writePrometheus(std::ostream &out) const;
+        };
+
+        /**
+         * @brief Format a label, escaping its value
+         *
+         * @param key The name of the label
+         * @param value The value of the label
+         * @return std::string The label (key="value")
+         */
+        std::string metricLabel(const std::string &key,
+                                const std::string &value);
+
+    } // namespace profiling
+} // namespace vazel
@@ -0,0 +1,140 @@
+/**
+ * include/Vazel/profiling/MetricsExporter/MetricsExporter.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/profiling/Metrics/Metrics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        /**
+         * @brief MetricsExporter publishes a Metrics registry from its own
+         * thread, so the frame loop never waits on a scrape: either by
+         * rewriting a Prometheus text file periodically (for the textfile
+         * collector of node_exporter) or by answering HTTP GET requests on a
+         * local UNIX socket.
+         *
+         */
+        class MetricsExporter
+        {
+          private:
+            Metrics &_metrics;
+            std::thread _thread;
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            std::atomic<bool> _running = false;
+            std::atomic<uint64_t> _exports = 0;
+            std::string _socket_path;
+            int _socket = -1;
+
+            /**
+             * @brief Rewrite the file every period until stopped
+             *
+             */
+            void __fileLoop(std::string path,
+                            std::chrono::milliseconds period);
+
+            /**
+             * @brief Serve the clients of the socket until stopped
+             *
+             */
+            void __socketLoop(void);
+
+          public:
+            /**
+             * @brief Construct a new Metrics Exporter object, it does nothing
+             * until started
+             *
+             * @param metrics The registry to export
+             */
+            MetricsExporter(Metrics &metrics = Metrics::getInstance());
+
+            /**
+             * @brief Stop the exporter and destroy it
+             *
+             */
+            ~MetricsExporter(void);
+
+            MetricsExporter(const MetricsExporter &) = delete;
+            MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+            /**
+             * @brief Write the metrics once in a file. The file is written
+             * next to path then renamed, a reader never sees it half written.
+             *
+             * @param path The path of the file
+             * @throw MetricsException The file cannot be written
+             */
+            void writeFile(const std::string &path);
+
+            /**
+             * @brief Write the metrics in a file now, then every period on
+             * the exporter thread (a failed write is retried at the next
+             * period)
+             *
+             * @param path The path of the file
+             * @param period The time between two writes
+             * @throw MetricsException The exporter is running, or the first
+             * write failed
+             */
+            void startFile(const std::string &path,
+                           std::chrono::milliseconds period);
+
+            /**
+             * @brief Serve the metrics over HTTP on a UNIX socket
+             * (curl --unix-socket path http://localhost/metrics), any
+             * existing file at path is replaced
+             *
+             * @param path The path of the socket
+             * @throw MetricsException The exporter is running, or the socket
+             * cannot be created (or the platform has no UNIX sockets)
+             */
+            void startSocket(const std::string &path);
+
+            /**
+             * @brief Stop the exporter thread (and remove the socket)
+             *
+             */
+            void stop(void);
+
+            /**
+             * @brief Check if the exporter thread is running
+             *
+             * @return bool True if it runs
+             */
+            bool isRunning(void) const;
+
+            /**
+             * @brief Get the number of files written or requests answered
+             *
+             * @return uint64_t The number of exports
+             */
+            uint64_t getExportCount(void) const;
+        };
+
+    } // namespace profiling
+} // namespace vazel
@@ -0,0 +1,251 @@
+/**
+ * include/Vazel/profiling/Trace/Trace.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ThreadSlot.hpp"
+#include "Vazel/VException.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief The number of events kept per thread, older events are overwritten
+ *
+ */
+#define VAZEL_TRACE_BUFFER_SIZE 16384
+
+/**
+ * @brief The maximum length of the name of an event (longer names are cut)
+ *
+ */
+#define VAZEL_TRACE_NAME_SIZE 32
+
+#define VAZEL_TRACE_CONCAT_(a, b) a##b
+#define VAZEL_TRACE_CONCAT(a, b) VAZEL_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief VAZEL_TRACE_SCOPE traces the enclosing scope when the library is
+ * built with VAZEL_ENABLE_TRACING, it compiles to nothing otherwise.
+ * The name only has to live until the end of the scope, the category must be
+ * a string literal.
+ *
+ *     VAZEL_TRACE_SCOPE("physics", "game");
+ *     VAZEL_TRACE_SCOPE_ID("level", "game", levelIndex);
+ *
+ */
+#ifdef VAZEL_ENABLE_TRACING
+#define VAZEL_TRACE_SCOPE(name, category)                                    \
+    ::vazel::profiling::TraceScope VAZEL_TRACE_CONCAT(__vazel_trace_,        \
+                                                      __LINE__)(name,        \
+                                                                category)
+#define VAZEL_TRACE_SCOPE_ID(name, category, id)                             \
+    ::vazel::profiling::TraceScope VAZEL_TRACE_CONCAT(__vazel_trace_,        \
+                                                      __LINE__)(name,        \
+                                                                category, id)
+#else
+#define VAZEL_TRACE_SCOPE(name, category) ((void)0)
+#define VAZEL_TRACE_SCOPE_ID(name, category, id) ((void)0)
+#endif
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        /**
+         * @brief TraceException is thrown when a trace cannot be written
+         *
+         */
+        class TraceException : public VException
+        {
+          private:
+            std::string _e = "TraceException: ";
+
+          public:
+            TraceException(const std::string &e);
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief A traced scope, one cache line
+         *
+         */
+        struct TraceEvent
+        {
+            char name[VAZEL_TRACE_NAME_SIZE];
+            const char *category;
+            int64_t begin;
+            int64_t duration;
+            uint64_t id;
+        };
+
+        /**
+         * @brief The value of TraceEvent::id when the event has no id
+         *
+         */
+        constexpr uint64_t noTraceId = UINT64_MAX;
+
+        /**
+         * @brief Tracer records the traced scopes of every thread in a ring
+         * buffer per thread slot, without locks, and writes them as a Chrome
+         * trace (chrome://tracing, ui.perfetto.dev). A scope is stored as one
+         * complete event so an overwritten event never leaves a begin without
+         * its end.
+         *
+         */
+        class Tracer
+        {
+          private:
+            struct alignas(64) Lane
+            {
+                std::atomic<TraceEvent *> events = nullptr;
+                std::atomic<uint64_t> head       = 0;
+            };
+
+            std::array<Lane, VAZEL_MAX_THREADS> _lanes;
+            std::atomic<bool> _recording = false;
+            const std::chrono::steady_clock::time_point _epoch;
+
+            Tracer(void);
+
+          public:
+            /**
+             * @brief Destroy the Tracer object and free its buffers
+             *
+             */
+            ~Tracer(void);
+
+            Tracer(const Tracer &) = delete;
+            Tracer &operator=(const Tracer &) = delete;
+
+            /**
+             * @brief Get the process tracer
+             *
+             * @return Tracer& The tracer
+             */
+            static Tracer &getInstance(void);
+
+            /**
+             * @brief Start recording (the buffer of a thread is allocated on
+             * its first event)
+             *
+             */
+            void start(void);
+
+            /**
+             * @brief Stop recording, the recorded events are kept
+             *
+             */
+            void stop(void);
+
+            /**
+             * @brief Check if the tracer records
+             *
+             * @return true The scopes are recorded
+             * @return false The scopes are ignored
+             */
+            bool isRecording(void) const;
+
+            /**
+             * @brief Record a scope of the calling thread
+             *
+             * @param name The name of the scope
+             * @param category The category of the scope (string literal)
+             * @param begin The start of the scope
+             * @param end The end of the scope
+             * @param id An optional id shown in the arguments of the event
+             */
+            void record(const char *name, const char *category,
+                        std::chrono::steady_clock::time_point begin,
+                        std::chrono::steady_clock::time_point end,
+                        uint64_t id = noTraceId);
+
+            /**
+             * @brief Forget the recorded events. No thread may record
+             * meanwhile.
+             *
+             */
+            void clear(void);
+
+            /**
+             * @brief Get the number of events kept in the buffers
+             *
+             * @return size_t The number of events
+             */
+            size_t getEventCount(void) const;
+
+            /**
+             * @brief Write the recorded events as a Chrome trace-event JSON.
+             * Stop the tracer first, an event being written meanwhile may be
+             * torn.
+             *
+             * @param out The stream to write to
+             */
+            void writeChromeTrace(std::ostream &out) const;
+
+            /**
+             * @brief Write the recorded events as a Chrome trace-event JSON
+             * file
+             *
+             * @param path The path of the file
+             * @throw TraceException The file cannot be written
+             */
+            void writeChromeTrace(const std::string &path) const;
+        };
+
+        /**
+         * @brief TraceScope records its lifetime in the tracer, if it
+         * records when the scope begins. Use VAZEL_TRACE_SCOPE instead so
+         * it can be compiled out.
+         *
+         */
+        class TraceScope
+        {
+          private:
+            const char *_name;
+            const char *_category;
+            uint64_t _id;
+            std::chrono::steady_clock::time_point _begin;
+
+          public:
+            /**
+             * @brief Begin a traced scope
+             *
+             * @param name The name of the scope
+             * @param category The category of the scope (string literal)
+             * @param id An optional id shown in the arguments of the event
+             */
+            TraceScope(const char *name, const char *category,
+                       uint64_t id = noTraceId);
+
+            /**
+             * @brief End the traced scope
+             *
+             */
+            ~TraceScope(void);
+
+            TraceScope(const TraceScope &) = delete;
+            TraceScope &operator=(const TraceScope &) = delete;
+        };
+
+    } // namespace profiling
+} // namespace vazel
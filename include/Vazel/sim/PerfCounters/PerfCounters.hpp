@@ -0,0 +1,96 @@
+/**
+ * include/Vazel/sim/PerfCounters/PerfCounters.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        /**
+         * @brief Hardware counter values (a counter the platform cannot
+         * measure stays at 0)
+         *
+         */
+        struct PerfSample
+        {
+            uint64_t cycles       = 0;
+            uint64_t instructions = 0;
+            uint64_t cacheMisses  = 0;
+            uint64_t branchMisses = 0;
+
+            PerfSample &operator+=(const PerfSample &other);
+            PerfSample operator-(const PerfSample &other) const;
+        };
+
+        /**
+         * @brief PerfCounters counts the cycles, instructions, cache misses
+         * and branch misses of the calling thread (user space only) with
+         * Linux perf_event_open. Elsewhere, or when the kernel refuses
+         * (perf_event_paranoid, no PMU in a VM...), it is not available and
+         * read does nothing. The counters that could be opened are read as
+         * one group so they cover the same instructions.
+         *
+         */
+        class PerfCounters
+        {
+          private:
+            std::array<int, 4> _fds;
+            std::array<uint64_t PerfSample::*, 4> _fields;
+            size_t _count = 0;
+
+          public:
+            /**
+             * @brief Open and start the counters of the calling thread
+             *
+             */
+            PerfCounters(void);
+
+            /**
+             * @brief Close the counters
+             *
+             */
+            ~PerfCounters(void);
+
+            PerfCounters(const PerfCounters &) = delete;
+            PerfCounters &operator=(const PerfCounters &) = delete;
+
+            /**
+             * @brief Check if at least one counter could be opened
+             *
+             * @return true The counters can be read
+             * @return false The platform does not allow it
+             */
+            bool isAvailable(void) const;
+
+            /**
+             * @brief Read the counters since they were opened
+             *
+             * @param out The sample to fill
+             * @return true The sample is filled
+             * @return false The counters are not available
+             */
+            bool read(PerfSample &out) const;
+        };
+
+    } // namespace sim
+} // namespace vazel
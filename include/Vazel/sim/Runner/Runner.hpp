@@ -0,0 +1,155 @@
+/**
+ * include/Vazel/sim/Runner/Runner.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/profiling/AllocTracker/AllocTracker.hpp"
+#include "Vazel/sim/PerfCounters/PerfCounters.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        /**
+         * @brief Time spent in one system during a run, and its hardware
+         * counters if they were enabled
+         *
+         */
+        struct SystemReport
+        {
+            std::string tag;
+            std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds max   = std::chrono::nanoseconds::zero();
+            size_t entities                = 0;
+            PerfSample counters;
+        };
+
+        /**
+         * @brief Result of a headless run, allocations counts the
+         * allocations of the ticks (with VAZEL_ENABLE_ALLOC_TRACKING)
+         *
+         */
+        struct SimulationReport
+        {
+            uint64_t ticks                   = 0;
+            std::chrono::nanoseconds elapsed = {};
+            size_t peakMemory                = 0;
+            bool hasPerfCounters             = false;
+            profiling::AllocStats allocations;
+            std::vector<SystemReport> systems;
+            std::vector<std::chrono::nanoseconds> frames;
+
+            /**
+             * @brief Get the throughput of the run
+             *
+             * @return double The number of ticks per second
+             */
+            double ticksPerSecond(void) const;
+
+            /**
+             * @brief Get a percentile of the duration of the ticks
+             *
+             * @param percent The percentile, in [0, 100]
+             * @return std::chrono::nanoseconds The duration (nearest rank,
+             * zero if there was no tick)
+             */
+            std::chrono::nanoseconds framePercentile(double percent) const;
+        };
+
+        /**
+         * @brief Runner updates a World as fast as possible (no pacing) and
+         * measures it. The time of every system is measured through a
+         * SystemProbe, it replaces the probe of the world during the run and
+         * forwards the updates to it.
+         *
+         */
+        class Runner : public ecs::SystemProbe
+        {
+          private:
+            ecs::World &_world;
+            ecs::SystemProbe *_next = nullptr;
+            std::unordered_map<const ecs::System *, size_t> _indices;
+            std::vector<SystemReport> _systems;
+            std::chrono::steady_clock::time_point _begin;
+            std::function<void(ecs::World &)> _on_tick;
+            bool _perf_enabled = false;
+            std::unique_ptr<PerfCounters> _perf;
+            PerfSample _perf_begin;
+
+          public:
+            /**
+             * @brief Construct a new Runner object
+             *
+             * @param world The world to run
+             */
+            Runner(ecs::World &world);
+
+            /**
+             * @brief Destroy the Runner object
+             *
+             */
+            ~Runner(void) = default;
+
+            /**
+             * @brief Run World::updateSystem
+             *
+             * @param ticks The number of updates
+             * @return SimulationReport The measures of the run
+             */
+            SimulationReport run(uint64_t ticks);
+
+            /**
+             * @brief Set a function called before every update, to spawn or
+             * destroy entities. Its time is part of the tick.
+             *
+             * @param onTick The function (empty to remove it)
+             */
+            void setOnTick(std::function<void(ecs::World &)> onTick);
+
+            /**
+             * @brief Count the hardware events of every system update in
+             * SystemReport::counters (see PerfCounters). Only the systems
+             * updated on the thread calling run are counted.
+             *
+             * @param enabled true to count them
+             */
+            void enablePerfCounters(bool enabled);
+
+            void onSystemBegin(const ecs::System &system) override;
+            void onSystemEnd(const ecs::System &system) override;
+        };
+
+        /**
+         * @brief Get the peak resident memory of the process
+         *
+         * @return size_t The peak memory in bytes (0 if it is not available
+         * on this platform)
+         */
+        size_t peakResidentMemory(void);
+
+    } // namespace sim
+} // namespace vazel
@@ -0,0 +1,136 @@
+/**
+ * include/Vazel/sim/Scenario/Scenario.hpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "Vazel/VException.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        /**
+         * @brief ScenarioException is thrown when a scenario cannot be read or
+         * does not fit in a World
+         *
+         */
+        class ScenarioException : public VException
+        {
+          private:
+            std::string _e = "ScenarioException: ";
+
+          public:
+            /**
+             * @brief Construct a new Scenario Exception object
+             *
+             * @param e The error message.
+             */
+            ScenarioException(const std::string &e);
+
+            /**
+             * @brief Get the what object.
+             *
+             * @return const char* The error message.
+             */
+            const char *what() const throw() override;
+        };
+
+        /**
+         * @brief Payload of the generated components, SimComponent<I> is the
+         * I-th component type of a scenario
+         *
+         * @tparam I The index of the component type
+         */
+        template <size_t I>
+        struct SimComponent
+        {
+            float value[4];
+        };
+
+        /**
+         * @brief A system of a scenario and the indices of the components it
+         * depends on. Every update it adds the other components to the first
+         * one.
+         *
+         */
+        struct ScenarioSystem
+        {
+            std::string tag;
+            std::vector<size_t> components;
+        };
+
+        /**
+         * @brief Description of a synthetic World.
+         *
+         * The text format has one directive per line, '#' starts a comment:
+         *
+         *     entities 10000        # number of entities
+         *     components 3          # number of component types
+         *     density 2 0.25        # ratio of entities having component 2
+         *     storage 2 paged       # dense, sparse (default) or paged
+         *     ticks 1000            # default number of ticks to run
+         *     seed 42               # seed used to pick the components
+         *     system move 0 1       # system tag then its components
+         *
+         * Every component has a density of 1 unless specified.
+         */
+        struct Scenario
+        {
+            size_t entities   = 0;
+            size_t components = 1;
+            uint64_t ticks    = 1000;
+            uint64_t seed     = 0;
+            std::vector<double> density;
+            std::vector<ecs::ComponentStorage> storage;
+            std::vector<ScenarioSystem> systems;
+        };
+
+        /**
+         * @brief Parse a scenario
+         *
+         * @param in The text of the scenario
+         * @return Scenario The scenario
+         */
+        Scenario parseScenario(std::istream &in);
+
+        /**
+         * @brief Read a scenario from a file
+         *
+         * @param path The path of the scenario
+         * @return Scenario The scenario
+         */
+        Scenario loadScenario(const std::string &path);
+
+        /**
+         * @brief Populate a World with the entities, components and systems of
+         * a scenario. The systems are registered once every entity is built
+         * so their entities are only computed once.
+         *
+         * @param world The world to populate (usually empty)
+         * @param scenario The scenario
+         */
+        void buildScenario(ecs::World &world, const Scenario &scenario);
+
+    } // namespace sim
+} // namespace vazel
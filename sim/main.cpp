@@ -0,0 +1,113 @@
+/**
+ * sim/main.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/sim.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+
+static int usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [--perf] <scenario> [ticks]\n", name);
+    return 2;
+}
+
+int main(int ac, char **av)
+{
+    const bool perf = ac > 1 && strcmp(av[1], "--perf") == 0;
+
+    if (perf) {
+        av++;
+        ac--;
+    }
+    if (ac < 2 || ac > 3) {
+        return usage(av[0]);
+    }
+    try {
+        vazel::sim::Scenario scenario = vazel::sim::loadScenario(av[1]);
+
+        if (ac == 3) {
+            scenario.ticks = std::stoull(av[2]);
+        }
+        vazel::ecs::World world;
+        vazel::sim::buildScenario(world, scenario);
+
+        vazel::sim::Runner runner(world);
+        runner.enablePerfCounters(perf);
+        const vazel::sim::SimulationReport report =
+            runner.run(scenario.ticks);
+        const double seconds =
+            std::chrono::duration<double>(report.elapsed).count();
+
+        printf("scenario     %s\n", av[1]);
+        printf("entities     %zu\n", scenario.entities);
+        printf("ticks        %lu\n", report.ticks);
+        printf("elapsed      %.3f s\n", seconds);
+        printf("ticks/s      %.1f\n", report.ticksPerSecond());
+        printf("frame p50    %.3f ms\n",
+               report.framePercentile(50).count() / 1e6);
+        printf("frame p99    %.3f ms\n",
+               report.framePercentile(99).count() / 1e6);
+        printf("peak memory  %.1f MiB\n", report.peakMemory / 1048576.0);
+        if (vazel::profiling::allocTrackingEnabled()) {
+            printf("allocs/tick  %.1f (%.1f KiB)\n",
+                   report.ticks ? double(report.allocations.allocations) /
+                                      report.ticks
+                                : 0,
+                   report.ticks ? report.allocations.bytes / 1024.0 /
+                                      report.ticks
+                                : 0);
+        }
+        printf("\n%-24s %12s %12s %8s\n", "system", "avg (us)", "max (us)",
+               "share");
+        for (const auto &it : report.systems) {
+            const double total =
+                std::chrono::duration<double, std::micro>(it.total).count();
+            const double max =
+                std::chrono::duration<double, std::micro>(it.max).count();
+
+            printf("%-24s %12.2f %12.2f %7.1f%%\n", it.tag.c_str(),
+                   report.ticks ? total / report.ticks : 0, max,
+                   seconds > 0 ? total / (seconds * 10000) : 0);
+        }
+        std::cout << "\n" << world.memoryReport();
+        if (perf && report.hasPerfCounters == false) {
+            printf("\nhardware counters are not available "
+                   "(see /proc/sys/kernel/perf_event_paranoid)\n");
+        } else if (perf) {
+            printf("\n%-24s %8s %14s %14s\n", "system", "IPC",
+                   "cache miss/e", "branch miss/e");
+            for (const auto &it : report.systems) {
+                const vazel::sim::PerfSample &c = it.counters;
+                // Per entity and per update
+                const double updates = static_cast<double>(report.ticks) *
+                                       std::max<size_t>(1, it.entities);
+
+                printf("%-24s %8.2f %14.3f %14.3f\n", it.tag.c_str(),
+                       c.cycles ? double(c.instructions) / c.cycles : 0,
+                       c.cacheMisses / updates, c.branchMisses / updates);
+            }
+        }
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
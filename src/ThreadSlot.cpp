@@ -0,0 +1,64 @@
+/**
+ * src/ThreadSlot.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ThreadSlot.hpp"
+
+#include <bitset>
+#include <mutex>
+
+namespace vazel
+{
+    static std::mutex s_slotsMut;
+    static std::bitset<VAZEL_MAX_THREADS> s_usedSlots;
+
+    namespace
+    {
+        // Owns the slot of a thread and gives it back when the thread exits
+        struct SlotOwner
+        {
+            size_t slot;
+
+            SlotOwner(void)
+            {
+                std::lock_guard<std::mutex> lock(s_slotsMut);
+
+                for (slot = 0; slot != VAZEL_MAX_THREADS; slot++) {
+                    if (s_usedSlots.test(slot) == false) {
+                        s_usedSlots.set(slot, true);
+                        return;
+                    }
+                }
+                throw ThreadSlotException();
+            }
+
+            ~SlotOwner(void)
+            {
+                std::lock_guard<std::mutex> lock(s_slotsMut);
+
+                s_usedSlots.set(slot, false);
+            }
+        };
+    } // namespace
+
+    size_t threadSlot(void)
+    {
+        static thread_local SlotOwner owner;
+
+        return owner.slot;
+    }
+
+} // namespace vazel
@@ -19,9 +19,11 @@
 
 namespace vazel
 {
-    static std::random_device s_randomDevice;
-    static std::mt19937_64 s_rEngine(s_randomDevice());
-    static std::uniform_int_distribution<UUID> s_uniformDistribution;
+    // Each thread owns its engine so Worlds can create entities from
+    // different threads (see core::WorldHost) without racing on the state.
+    static thread_local std::mt19937_64 s_rEngine(std::random_device {}());
+    static thread_local std::uniform_int_distribution<UUID>
+        s_uniformDistribution;
 
     UUID makeUUID(void)
     {
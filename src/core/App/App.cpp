@@ -17,7 +17,9 @@
  */
 
 #include "Vazel/core/App/App.hpp"
+#include "Vazel/profiling/Trace/Trace.hpp"
 
+#include <algorithm>
 #include <mutex>
 
 namespace vazel
@@ -27,7 +29,7 @@ namespace vazel
     namespace core
     {
 
-        static App *instance = nullptr;
+        App *App::instance = nullptr;
 
         AppException::AppException(const std::string &e)
             : _e(e)
@@ -41,7 +43,9 @@ namespace vazel
 
         void App::stop(void)
         {
+            __cancelLoading();
             _pending_state = nullptr;
+            _transition    = Transition::Stop;
             if (_current_state != nullptr) {
                 _current_state->exit(*this);
             }
@@ -62,7 +66,123 @@ namespace vazel
             if (_current_state != nullptr) {
                 _current_state->exit(*this);
             }
+            __cancelLoading();
             _pending_state = it->get();
+            _transition    = Transition::Set;
+        }
+
+        void App::pushState(StateTag stateTag)
+        {
+            const auto it = getStateFromTag(_states, stateTag);
+
+            if (it == _states.end()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "App::pushState: Could not find State with tag: "
+                         "\"%lu\"",
+                         stateTag);
+                throw AppException(buf);
+            }
+            const bool suspended =
+                std::find_if(_stack.begin(), _stack.end(),
+                             [&it](const SuspendedState &s) {
+                                 return s.state == it->get();
+                             }) != _stack.end();
+
+            if (it->get() == _current_state || suspended) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "App::pushState: State with tag: \"%lu\" is already "
+                         "on the stack",
+                         stateTag);
+                throw AppException(buf);
+            }
+            __cancelLoading();
+            _pending_state = it->get();
+            _transition =
+                _current_state != nullptr ? Transition::Push : Transition::Set;
+        }
+
+        void App::popState(void)
+        {
+            if (_current_state == nullptr) {
+                throw AppException("App::popState: There is no state running");
+            }
+            __cancelLoading();
+            _current_state->exit(*this);
+            _pending_state = nullptr;
+            _transition    = Transition::Pop;
+        }
+
+        void App::setStateAsync(StateTag stateTag)
+        {
+            const auto it = getStateFromTag(_states, stateTag);
+
+            if (it == _states.end()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "App::setStateAsync: Could not find State with tag: "
+                         "\"%lu\"",
+                         stateTag);
+                throw AppException(buf);
+            }
+            if (_loading_state != nullptr) {
+                throw AppException(
+                    "App::setStateAsync: A state is already loading");
+            }
+            if (_loading.valid()) {
+                // A cancelled load still owns the staging world
+                _loading.wait();
+            }
+            _staging          = std::make_unique<ecs::World>();
+            _loading_state    = it->get();
+            State *state      = _loading_state;
+            ecs::World *world = _staging.get();
+
+            _loading = std::async(std::launch::async,
+                                  [state, world]() { state->load(*world); });
+        }
+
+        bool App::isLoading(void) const
+        {
+            return _loading_state != nullptr;
+        }
+
+        void App::__cancelLoading(void)
+        {
+            _loading_state = nullptr;
+        }
+
+        void App::__pollLoading(void)
+        {
+            if (_loading.valid() == false ||
+                _loading.wait_for(std::chrono::seconds(0)) !=
+                    std::future_status::ready) {
+                return;
+            }
+            State *loaded = _loading_state;
+
+            _loading_state = nullptr;
+            try {
+                _loading.get();
+            } catch (...) {
+                _staging.reset();
+                throw;
+            }
+            if (loaded == nullptr) {
+                _staging.reset();
+                return;
+            }
+            if (_current_state != nullptr) {
+                _current_state->exit(*this);
+            }
+            _pending_state = loaded;
+            _transition    = Transition::Swap;
+        }
+
+        size_t App::getSuspendedCount(void) const
+        {
+            return _stack.size();
         }
 
         void App::registerState(State &state)
@@ -85,19 +205,213 @@ namespace vazel
 
         void App::run(void)
         {
-            if (_pending_state == nullptr)
+            if (_pending_state == nullptr && _loading_state == nullptr)
                 throw AppException("There is no pending scene right now");
-            while (_pending_state != nullptr) {
-                _current_state = _pending_state;
-                _current_state->init(*this);
-                _pending_state = nullptr;
-                while (_current_state->isRunning()) {
-                    _current_state->update(*this);
+            if (_pending_state == nullptr) {
+                // Nothing to update while the first state loads
+                _loading.wait();
+                __pollLoading();
+            }
+            __applyTransition();
+            clock.reset();
+            if (watchdog.isEnabled()) {
+                watchdog.attach(world);
+            }
+            while (_current_state != nullptr) {
+                // A replay runs as fast as possible, one update per frame
+                const unsigned steps =
+                    _replay != nullptr ? 1 : clock.beginFrame();
+                // The frame slice ends before the pacing sleep, traced as
+                // "idle"
+                {
+                    VAZEL_TRACE_SCOPE_ID("frame", "app", _frame);
+                    const auto begin     = std::chrono::steady_clock::now();
+                    const uint64_t frame = _frame;
+
+                    if (_pending_events != nullptr) {
+                        _pending_events->set(Keyboard::pending());
+                    }
+                    if (watchdog.isEnabled()) {
+                        watchdog.beginFrame(world);
+                    }
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+                    profiling::AllocScope frameAllocations(
+                        watchdog.allocations());
+#endif
+
+                    for (unsigned i = 0; i != steps &&
+                                         _transition == Transition::None &&
+                                         _current_state->isRunning();
+                         i++) {
+                        if (__beginFrame() == false) {
+                            break;
+                        }
+                        world.setDeltaTime(clock.getDeltaTime());
+                        _current_state->update(*this);
+                        _frame++;
+                    }
+                    if (_transition == Transition::None) {
+                        __pollLoading();
+                    }
+                    const std::chrono::nanoseconds elapsed =
+                        std::chrono::steady_clock::now() - begin;
+
+                    if (_frame_time != nullptr) {
+                        _frame_time->observe(elapsed);
+                    }
+                    if (watchdog.isEnabled()) {
+                        watchdog.endFrame(world, frame, elapsed);
+                    }
+                }
+                if (_transition != Transition::None ||
+                    _current_state->isRunning() == false) {
+                    __applyTransition();
+                    clock.reset();
+                } else if (_replay == nullptr) {
+                    VAZEL_TRACE_SCOPE("idle", "app");
+
+                    clock.endFrame();
                 }
-                _current_state->rexit(*this);
+            }
+            watchdog.detach(world);
+            if (_loading.valid()) {
+                _loading.wait();
+                _loading = std::future<void>();
+                _staging.reset();
+            }
+        }
+
+        void App::setBackgroundTeardown(bool enabled)
+        {
+            _background_teardown = enabled;
+        }
+
+        void App::__clearWorld(void)
+        {
+            if (_background_teardown) {
+                world.clearWorldAsync();
+            } else {
                 world.clearWorld();
             }
-            _current_state = nullptr;
+        }
+
+        void App::__popState(void)
+        {
+            _current_state->rexit(*this);
+            __clearWorld();
+            if (_stack.empty()) {
+                _current_state = nullptr;
+                return;
+            }
+            world.swap(*_stack.back().world);
+            _current_state = _stack.back().state;
+            _stack.pop_back();
+        }
+
+        void App::__applyTransition(void)
+        {
+            // The states may ask for another transition while they init
+            const Transition transition = _transition;
+            State *pending              = _pending_state;
+
+            _transition    = Transition::None;
+            _pending_state = nullptr;
+            switch (transition) {
+            case Transition::Set:
+                if (_current_state != nullptr) {
+                    _current_state->rexit(*this);
+                    __clearWorld();
+                }
+                _current_state = pending;
+                _current_state->init(*this);
+                break;
+            case Transition::Push:
+                _stack.push_back(
+                    { _current_state, std::make_unique<ecs::World>() });
+                world.swap(*_stack.back().world);
+                _current_state = pending;
+                _current_state->init(*this);
+                break;
+            case Transition::Swap:
+                if (_current_state != nullptr) {
+                    _current_state->rexit(*this);
+                    __clearWorld();
+                }
+                world.swap(*_staging);
+                _staging.reset();
+                _current_state = pending;
+                _current_state->init(*this);
+                break;
+            case Transition::Pop:
+                __popState();
+                break;
+            case Transition::Stop:
+                while (_current_state != nullptr) {
+                    __popState();
+                }
+                break;
+            case Transition::None:
+                if (_current_state != nullptr &&
+                    _current_state->isRunning() == false) {
+                    __popState();
+                }
+                break;
+            }
+        }
+
+        uint64_t App::getFrame(void) const
+        {
+            return _frame;
+        }
+
+        double App::getDeltaTime(void) const
+        {
+            return world.getDeltaTime();
+        }
+
+        void App::setInputRecorder(InputRecorder *recorder)
+        {
+            _recorder = recorder;
+            Keyboard::setRecorder(recorder);
+        }
+
+        void App::setInputReplay(InputReplay *replay)
+        {
+            _replay = replay;
+        }
+
+        void App::setMetrics(profiling::Metrics *metrics)
+        {
+            if (metrics == nullptr) {
+                world.setMetrics(nullptr);
+                _world_metrics.reset();
+                _frame_time     = nullptr;
+                _pending_events = nullptr;
+                return;
+            }
+            _world_metrics =
+                std::make_unique<ecs::WorldMetrics>("app", *metrics);
+            world.setMetrics(_world_metrics.get());
+            _frame_time     = &metrics->histogram(
+                "vazel_frame_seconds", "Duration of the frames of the app");
+            _pending_events = &metrics->gauge(
+                "vazel_keyboard_events_pending",
+                "Keyboard events waiting at the beginning of a frame");
+        }
+
+        bool App::__beginFrame(void)
+        {
+            if (_recorder != nullptr) {
+                _recorder->setFrame(_frame);
+            }
+            if (_replay != nullptr) {
+                if (_replay->isFinished(_frame)) {
+                    stop();
+                    return false;
+                }
+                _replay->feed(_frame);
+            }
+            return true;
         }
 
         const std::vector<std::unique_ptr<State>>::iterator getStateFromTag(
@@ -16,31 +16,52 @@
 
 #include "Vazel/core/Event/Event.hpp"
 
+#include "Vazel/core/Event/InputRecorder.hpp"
+
 namespace vazel
 {
     namespace core
     {
-        std::mutex Keyboard::_keyboardMut;
-        std::queue<Keyboard::Input> Keyboard::_events;
+        RingBuffer<Keyboard::Input, VAZEL_KEYBOARD_EVENT_CAPACITY>
+            Keyboard::_events;
+        InputRecorder *Keyboard::_recorder = nullptr;
 
         bool Keyboard::poll(Keyboard::Input& type)
         {
-            _keyboardMut.lock();
-            if (_events.empty()) {
-                _keyboardMut.unlock();
+            if (_events.pop(type) == false) {
                 return false;
             }
-            type = _events.front();
-            _events.pop();
-            _keyboardMut.unlock();
+            if (_recorder != nullptr) {
+                _recorder->record(type);
+            }
             return true;
         }
 
-        void Keyboard::pushEvent(const Keyboard::Input& type)
+        size_t Keyboard::drain(std::span<Keyboard::Input> events)
+        {
+            const size_t count = _events.drain(events);
+
+            if (_recorder != nullptr) {
+                for (size_t i = 0; i != count; i++) {
+                    _recorder->record(events[i]);
+                }
+            }
+            return count;
+        }
+
+        bool Keyboard::pushEvent(const Keyboard::Input& type)
+        {
+            return _events.push(type);
+        }
+
+        size_t Keyboard::pending(void)
+        {
+            return _events.size();
+        }
+
+        void Keyboard::setRecorder(InputRecorder *recorder)
         {
-            _keyboardMut.lock();
-            _events.push(type);
-            _keyboardMut.unlock();
+            _recorder = recorder;
         }
     } // namespace core
 } // namespace vazel
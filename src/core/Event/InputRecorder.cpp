@@ -0,0 +1,177 @@
+/**
+ * src/core/Event/InputRecorder.cpp
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Vazel/core/Event/InputRecorder.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace vazel
+{
+    namespace core
+    {
+        static const char s_magic[4]  = { 'V', 'Z', 'I', 'L' };
+        static const uint8_t s_version = 1;
+
+        static void writeVarint(std::string &out, uint64_t value)
+        {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        static uint64_t readVarint(const std::string &in, size_t &pos)
+        {
+            uint64_t value = 0;
+
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (pos >= in.size()) {
+                    throw InputLogException(
+                        "readVarint: Unexpected end of the input log");
+                }
+                const uint8_t byte = static_cast<uint8_t>(in[pos++]);
+
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw InputLogException("readVarint: Invalid varint");
+        }
+
+        InputLogException::InputLogException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *InputLogException::what(void) const throw()
+        {
+            return _e.c_str();
+        }
+
+        void InputRecorder::setFrame(uint64_t frame)
+        {
+            _frame = frame;
+        }
+
+        void InputRecorder::record(Keyboard::Input input)
+        {
+            _records.push_back({ _frame, input });
+        }
+
+        const std::vector<InputRecord> &InputRecorder::getRecords(void) const
+        {
+            return _records;
+        }
+
+        void InputRecorder::save(const std::string &path,
+                                 uint64_t endFrame) const
+        {
+            std::string out(s_magic, sizeof(s_magic));
+            uint64_t previous = 0;
+
+            out.push_back(static_cast<char>(s_version));
+            writeVarint(out, endFrame);
+            writeVarint(out, _records.size());
+            for (const auto &it : _records) {
+                writeVarint(out, it.frame - previous);
+                // Unknown is -1, shift by one so every input fits in a byte
+                out.push_back(static_cast<char>(it.input + 1));
+                previous = it.frame;
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file.write(out.data(), out.size())) {
+                throw InputLogException("InputRecorder::save: Cannot write " +
+                                        path);
+            }
+        }
+
+        InputReplay::InputReplay(const std::string &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+
+            if (!file) {
+                throw InputLogException("InputReplay::InputReplay: Cannot "
+                                        "open " +
+                                        path);
+            }
+            const std::string in((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+            size_t pos = sizeof(s_magic) + 1;
+
+            if (in.size() < pos ||
+                std::memcmp(in.data(), s_magic, sizeof(s_magic)) != 0 ||
+                static_cast<uint8_t>(in[sizeof(s_magic)]) != s_version) {
+                throw InputLogException("InputReplay::InputReplay: " + path +
+                                        " is not an input log");
+            }
+            _end_frame           = readVarint(in, pos);
+            const uint64_t count = readVarint(in, pos);
+            uint64_t frame       = 0;
+
+            _records.reserve(count);
+            for (uint64_t i = 0; i != count; i++) {
+                frame += readVarint(in, pos);
+                if (pos >= in.size()) {
+                    throw InputLogException("InputReplay::InputReplay: "
+                                            "Unexpected end of " +
+                                            path);
+                }
+                const int input = static_cast<uint8_t>(in[pos++]) - 1;
+
+                _records.push_back(
+                    { frame, static_cast<Keyboard::Input>(input) });
+            }
+        }
+
+        void InputReplay::feed(uint64_t frame)
+        {
+            while (_next != _records.size() && _records[_next].frame <= frame) {
+                if (Keyboard::pushEvent(_records[_next].input) == false) {
+                    throw InputLogException(
+                        "InputReplay::feed: The keyboard queue is full, the "
+                        "replay would not be deterministic");
+                }
+                _next++;
+            }
+        }
+
+        bool InputReplay::isFinished(uint64_t frame) const
+        {
+            return _next == _records.size() && frame >= _end_frame;
+        }
+
+        uint64_t InputReplay::getEndFrame(void) const
+        {
+            return _end_frame;
+        }
+
+        const std::vector<InputRecord> &InputReplay::getRecords(void) const
+        {
+            return _records;
+        }
+
+        void InputReplay::rewind(void)
+        {
+            _next = 0;
+        }
+
+    } // namespace core
+} // namespace vazel
@@ -0,0 +1,148 @@
+/**
+ * src/core/FrameClock/FrameClock.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/FrameClock/FrameClock.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        void preciseSleepUntil(std::chrono::steady_clock::time_point deadline)
+        {
+            // The scheduler may wake us up around a millisecond late
+            constexpr auto slack = std::chrono::milliseconds(1);
+
+            if (deadline - std::chrono::steady_clock::now() > slack) {
+                std::this_thread::sleep_until(deadline - slack);
+            }
+            while (std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+
+        FrameClock::FrameClock(void)
+        {
+            reset();
+        }
+
+        void FrameClock::setFixedStep(std::chrono::nanoseconds step)
+        {
+            _fixed_step  = step;
+            _accumulator = {};
+        }
+
+        void FrameClock::setMaxSteps(unsigned steps)
+        {
+            _max_steps = std::max(steps, 1u);
+        }
+
+        void FrameClock::setFrameRateLimit(double fps)
+        {
+            if (fps <= 0) {
+                _frame_limit = {};
+                return;
+            }
+            _frame_limit = std::chrono::nanoseconds(
+                static_cast<int64_t>(1000000000.0 / fps));
+        }
+
+        std::chrono::nanoseconds FrameClock::getFixedStep(void) const
+        {
+            return _fixed_step;
+        }
+
+        unsigned FrameClock::getMaxSteps(void) const
+        {
+            return _max_steps;
+        }
+
+        void FrameClock::reset(void)
+        {
+            _last_frame  = clock::now();
+            _accumulator = {};
+            _frame_time  = {};
+        }
+
+        unsigned FrameClock::beginFrame(void)
+        {
+            const clock::time_point now = clock::now();
+
+            _frame_time = now - _last_frame;
+            _last_frame = now;
+            if (_fixed_step == std::chrono::nanoseconds::zero()) {
+                return 1;
+            }
+            _accumulator += _frame_time;
+
+            uint64_t steps = _accumulator / _fixed_step;
+
+            if (steps > _max_steps) {
+                _dropped_steps += steps - _max_steps;
+                steps = _max_steps;
+                _accumulator %= _fixed_step;
+            } else {
+                _accumulator -= steps * _fixed_step;
+            }
+            return steps;
+        }
+
+        void FrameClock::endFrame(void)
+        {
+            clock::time_point deadline = _last_frame + _frame_limit;
+
+            if (_fixed_step != std::chrono::nanoseconds::zero()) {
+                deadline = std::max(deadline,
+                                    _last_frame + _fixed_step - _accumulator);
+            }
+            if (deadline > clock::now()) {
+                preciseSleepUntil(deadline);
+            }
+        }
+
+        double FrameClock::getDeltaTime(void) const
+        {
+            const std::chrono::nanoseconds delta =
+                _fixed_step == std::chrono::nanoseconds::zero() ? _frame_time
+                                                                : _fixed_step;
+
+            return std::chrono::duration<double>(delta).count();
+        }
+
+        std::chrono::nanoseconds FrameClock::getFrameTime(void) const
+        {
+            return _frame_time;
+        }
+
+        double FrameClock::getInterpolation(void) const
+        {
+            if (_fixed_step == std::chrono::nanoseconds::zero()) {
+                return 0;
+            }
+            return std::chrono::duration<double>(_accumulator) / _fixed_step;
+        }
+
+        uint64_t FrameClock::getDroppedSteps(void) const
+        {
+            return _dropped_steps;
+        }
+
+    } // namespace core
+} // namespace vazel
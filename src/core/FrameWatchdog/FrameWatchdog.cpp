@@ -0,0 +1,205 @@
+/**
+ * src/core/FrameWatchdog/FrameWatchdog.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/FrameWatchdog/FrameWatchdog.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        FrameWatchdogException::FrameWatchdogException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *FrameWatchdogException::what() const throw()
+        {
+            return _e.c_str();
+        }
+
+        void FrameWatchdog::setBudget(std::chrono::nanoseconds budget,
+                                      size_t capacity)
+        {
+            _budget   = budget;
+            _capacity = std::max<size_t>(capacity, 1);
+            clear();
+        }
+
+        std::chrono::nanoseconds FrameWatchdog::getBudget(void) const
+        {
+            return _budget;
+        }
+
+        bool FrameWatchdog::isEnabled(void) const
+        {
+            return _budget.count() > 0;
+        }
+
+        void FrameWatchdog::attach(ecs::World &world)
+        {
+            if (world.getSystemProbe() == this) {
+                // Left attached by a run that threw
+                return;
+            }
+            _next = world.getSystemProbe();
+            world.setSystemProbe(this);
+        }
+
+        void FrameWatchdog::detach(ecs::World &world)
+        {
+            if (world.getSystemProbe() == this) {
+                world.setSystemProbe(_next);
+            }
+            _next = nullptr;
+        }
+
+        void FrameWatchdog::beginFrame(const ecs::World &world)
+        {
+            _system_count = 0;
+            _changes      = world.getStructuralChanges();
+            _allocations.reset();
+        }
+
+        void FrameWatchdog::endFrame(const ecs::World &world, uint64_t frame,
+                                     std::chrono::nanoseconds duration)
+        {
+            if (duration <= _budget) {
+                return;
+            }
+            SlowFrame report;
+
+            report.allocations = _allocations.get();
+            report.frame       = frame;
+            report.duration    = duration;
+            report.budget      = _budget;
+            report.changes     = world.getStructuralChanges() - _changes;
+            report.systems.assign(_systems.begin(),
+                                  _systems.begin() + _system_count);
+            if (_reports.size() < _capacity) {
+                _reports.push_back(std::move(report));
+            } else {
+                _reports[_slow_count % _capacity] = std::move(report);
+            }
+            _slow_count++;
+        }
+
+        profiling::AllocCounter &FrameWatchdog::allocations(void)
+        {
+            return _allocations;
+        }
+
+        std::vector<SlowFrame> FrameWatchdog::getReports(void) const
+        {
+            std::vector<SlowFrame> reports = _reports;
+
+            if (reports.size() == _capacity) {
+                // The oldest frame is the next one overwritten
+                std::rotate(reports.begin(),
+                            reports.begin() + _slow_count % _capacity,
+                            reports.end());
+            }
+            return reports;
+        }
+
+        uint64_t FrameWatchdog::getSlowFrameCount(void) const
+        {
+            return _slow_count;
+        }
+
+        void FrameWatchdog::clear(void)
+        {
+            _reports.clear();
+            _slow_count = 0;
+        }
+
+        void FrameWatchdog::writeReports(const std::string &path) const
+        {
+            std::ofstream file(path);
+
+            for (const auto &it : getReports()) {
+                file << it << std::endl;
+            }
+            if (!file) {
+                throw FrameWatchdogException(
+                    "FrameWatchdog::writeReports: Cannot write " + path);
+            }
+        }
+
+        void FrameWatchdog::onSystemBegin(const ecs::System &system)
+        {
+            if (_next != nullptr) {
+                _next->onSystemBegin(system);
+            }
+            _system_begin = std::chrono::steady_clock::now();
+        }
+
+        void FrameWatchdog::onSystemEnd(const ecs::System &system)
+        {
+            const std::chrono::nanoseconds duration =
+                std::chrono::steady_clock::now() - _system_begin;
+
+            if (_system_count == _systems.size()) {
+                _systems.emplace_back();
+            }
+            SystemTiming &timing = _systems[_system_count++];
+
+            // Reuses the capacity of the tag of the previous frames
+            timing.tag      = system.getTag();
+            timing.duration = duration;
+            timing.entities = system.getEntityCount();
+            if (_next != nullptr) {
+                _next->onSystemEnd(system);
+            }
+        }
+
+        std::ostream &operator<<(std::ostream &os, const SlowFrame &frame)
+        {
+            std::vector<SystemTiming> systems = frame.systems;
+            char buf[BUFSIZ]                  = { 0 };
+
+            std::stable_sort(systems.begin(), systems.end(),
+                             [](const SystemTiming &a, const SystemTiming &b) {
+                                 return a.duration > b.duration;
+                             });
+            snprintf(buf, sizeof(buf) - 1,
+                     "frame %lu: %.3f ms (budget %.3f ms)\n", frame.frame,
+                     frame.duration.count() / 1e6, frame.budget.count() / 1e6);
+            os << buf;
+            for (const auto &it : systems) {
+                snprintf(buf, sizeof(buf) - 1, "  %-24s %10.3f ms %10zu\n",
+                         it.tag.c_str(), it.duration.count() / 1e6,
+                         it.entities);
+                os << buf;
+            }
+            snprintf(buf, sizeof(buf) - 1,
+                     "  entities +%lu -%lu, components +%lu -%lu\n"
+                     "  allocations %lu (%lu bytes)\n",
+                     frame.changes.entitiesCreated,
+                     frame.changes.entitiesRemoved,
+                     frame.changes.componentsAttached,
+                     frame.changes.componentsDetached,
+                     frame.allocations.allocations, frame.allocations.bytes);
+            return os << buf;
+        }
+
+    } // namespace core
+} // namespace vazel
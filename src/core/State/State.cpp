@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Vazel/core/State/State.hpp"
+#include "Vazel/profiling/Trace/Trace.hpp"
 
 namespace vazel
 {
@@ -53,19 +54,37 @@ namespace vazel
             return _tag;
         }
 
+        void State::setOnLoad(std::function<void(ecs::World &)> on_load)
+        {
+            _on_load = on_load;
+        }
+
+        void State::load(ecs::World &world)
+        {
+            if (_on_load) {
+                _on_load(world);
+            }
+        }
+
         void State::init(App &app)
         {
+            VAZEL_TRACE_SCOPE_ID("State::init", "state", _tag);
+
             _is_running = true;
             _on_init(app);
         }
 
         void State::update(App &app)
         {
+            VAZEL_TRACE_SCOPE_ID("State::update", "state", _tag);
+
             _on_update(app);
         }
 
         void State::rexit(App &app)
         {
+            VAZEL_TRACE_SCOPE_ID("State::rexit", "state", _tag);
+
             _is_running = false;
             _on_exit(app);
         }
@@ -0,0 +1,211 @@
+/**
+ * src/core/WorldHost/WorldHost.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/WorldHost/WorldHost.hpp"
+#include "Vazel/profiling/Trace/Trace.hpp"
+
+#include <algorithm>
+
+namespace vazel
+{
+    namespace core
+    {
+
+        WorldHostException::WorldHostException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *WorldHostException::what(void) const throw()
+        {
+            return _e.c_str();
+        }
+
+        std::chrono::nanoseconds WorldTickStats::mean(void) const
+        {
+            if (ticks == 0) {
+                return std::chrono::nanoseconds::zero();
+            }
+            return total / ticks;
+        }
+
+        WorldHost::WorldHost(size_t workers)
+        {
+            _workers.reserve(workers);
+            for (size_t i = 0; i != workers; i++) {
+                _workers.emplace_back(&WorldHost::__workerLoop, this);
+            }
+        }
+
+        WorldHost::~WorldHost(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _stopping = true;
+            }
+            _cv_work.notify_all();
+            for (auto &it : _workers) {
+                it.join();
+            }
+        }
+
+        WorldHost::HostedWorld &WorldHost::__getHostedWorld(WorldId id) const
+        {
+            if (id >= _worlds.size() || _worlds[id] == nullptr) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "WorldHost::__getHostedWorld: World %lu does not "
+                         "exist",
+                         id);
+                throw WorldHostException(buf);
+            }
+            return *_worlds[id];
+        }
+
+        WorldId WorldHost::addWorld(std::chrono::nanoseconds budget)
+        {
+            const auto it = std::find(_worlds.begin(), _worlds.end(), nullptr);
+            auto hosted   = std::make_unique<HostedWorld>();
+
+            hosted->budget = budget;
+            _schedule.push_back(hosted.get());
+            if (it != _worlds.end()) {
+                *it = std::move(hosted);
+                return it - _worlds.begin();
+            }
+            _worlds.push_back(std::move(hosted));
+            return _worlds.size() - 1;
+        }
+
+        void WorldHost::removeWorld(WorldId id)
+        {
+            HostedWorld *hosted = &__getHostedWorld(id);
+
+            _schedule.erase(
+                std::find(_schedule.begin(), _schedule.end(), hosted));
+            _worlds[id].reset();
+        }
+
+        ecs::World &WorldHost::getWorld(WorldId id)
+        {
+            return __getHostedWorld(id).world;
+        }
+
+        void WorldHost::setFrameBudget(WorldId id,
+                                       std::chrono::nanoseconds budget)
+        {
+            __getHostedWorld(id).budget = budget;
+        }
+
+        const WorldTickStats &WorldHost::getStats(WorldId id) const
+        {
+            return __getHostedWorld(id).stats;
+        }
+
+        size_t WorldHost::size(void) const
+        {
+            return _schedule.size();
+        }
+
+        size_t WorldHost::workerCount(void) const
+        {
+            return _workers.size();
+        }
+
+        void WorldHost::__runJobs(void)
+        {
+            while (true) {
+                const size_t job = _next_job++;
+
+                if (job >= _schedule.size()) {
+                    return;
+                }
+                VAZEL_TRACE_SCOPE_ID("WorldHost job", "job", job);
+                HostedWorld &hosted = *_schedule[job];
+                const auto begin    = std::chrono::steady_clock::now();
+
+                try {
+                    hosted.world.updateSystem();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mut);
+                    if (_error == nullptr) {
+                        _error = std::current_exception();
+                    }
+                }
+
+                WorldTickStats &stats = hosted.stats;
+
+                stats.last = std::chrono::steady_clock::now() - begin;
+                stats.min  = std::min(stats.min, stats.last);
+                stats.max  = std::max(stats.max, stats.last);
+                stats.total += stats.last;
+                stats.ticks++;
+                if (hosted.budget != std::chrono::nanoseconds::zero() &&
+                    stats.last > hosted.budget) {
+                    stats.overruns++;
+                }
+            }
+        }
+
+        void WorldHost::__workerLoop(void)
+        {
+            std::unique_lock<std::mutex> lock(_mut);
+            // Workers are spawned by the constructor, before the first tick
+            uint64_t seen = 0;
+
+            while (true) {
+                _cv_work.wait(lock, [&] {
+                    return _stopping || _generation != seen;
+                });
+                if (_stopping) {
+                    return;
+                }
+                seen = _generation;
+                lock.unlock();
+                __runJobs();
+                lock.lock();
+                if (--_busy_workers == 0) {
+                    _cv_done.notify_all();
+                }
+            }
+        }
+
+        void WorldHost::tick(void)
+        {
+            std::stable_sort(_schedule.begin(), _schedule.end(),
+                             [](HostedWorld *a, HostedWorld *b) {
+                                 return a->stats.last > b->stats.last;
+                             });
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _next_job     = 0;
+                _busy_workers = _workers.size();
+                _error        = nullptr;
+                _generation++;
+            }
+            _cv_work.notify_all();
+            __runJobs();
+
+            std::unique_lock<std::mutex> lock(_mut);
+            _cv_done.wait(lock, [&] { return _busy_workers == 0; });
+            if (_error != nullptr) {
+                std::rethrow_exception(_error);
+            }
+        }
+
+    } // namespace core
+} // namespace vazel
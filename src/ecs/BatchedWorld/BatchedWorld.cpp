@@ -0,0 +1,246 @@
+/**
+ * src/ecs/BatchedWorld/BatchedWorld.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/BatchedWorld/BatchedWorld.hpp"
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        BatchedWorldException::BatchedWorldException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *BatchedWorldException::what(void) const throw()
+        {
+            return _e.c_str();
+        }
+
+        static void unimplementedOnUpdateBatchedSystem(
+            BatchedWorld &world, std::span<const uint8_t> mask)
+        {
+            (void)world;
+            (void)mask;
+        }
+
+        BatchedSystem::BatchedSystem(const std::string &tag)
+            : _tag(tag)
+            , _on_update(unimplementedOnUpdateBatchedSystem)
+        {
+        }
+
+        void BatchedSystem::addDependency(const ComponentType &type)
+        {
+            _signature.set(type, true);
+        }
+
+        void BatchedSystem::setOnUpdate(batchedSystemUpdate updater)
+        {
+            _on_update = updater;
+        }
+
+        const ComponentSignature &BatchedSystem::getSignature(void) const
+        {
+            return _signature;
+        }
+
+        const std::string &BatchedSystem::getTag(void) const
+        {
+            return _tag;
+        }
+
+        void BatchedSystem::onUpdate(BatchedWorld &world,
+                                     std::span<const uint8_t> mask) const
+        {
+            _on_update(world, mask);
+        }
+
+        BatchedWorld::BatchedWorld(size_t environments, size_t capacity)
+            : _environments(environments)
+            , _capacity(capacity)
+            , _signatures(environments * capacity)
+            , _alive(environments * capacity, 0)
+            , _free_entities(environments)
+        {
+            for (auto &it : _free_entities) {
+                it.reserve(capacity);
+                for (size_t i = capacity; i != 0; i--) {
+                    it.push_back(i - 1);
+                }
+            }
+        }
+
+        size_t BatchedWorld::environments(void) const
+        {
+            return _environments;
+        }
+
+        size_t BatchedWorld::capacity(void) const
+        {
+            return _capacity;
+        }
+
+        size_t BatchedWorld::slots(void) const
+        {
+            return _environments * _capacity;
+        }
+
+        size_t BatchedWorld::slotOf(size_t env, BatchEntity e) const
+        {
+            return env * _capacity + e;
+        }
+
+        size_t BatchedWorld::__getSlot(size_t env, BatchEntity e) const
+        {
+            if (env >= _environments || e >= _capacity ||
+                _alive[slotOf(env, e)] == 0) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "BatchedWorld::__getSlot: Entity(%u) does not exist "
+                         "in environment %lu",
+                         e, env);
+                throw BatchedWorldException(buf);
+            }
+            return slotOf(env, e);
+        }
+
+        BatchEntity BatchedWorld::createEntity(size_t env)
+        {
+            if (env >= _environments) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "BatchedWorld::createEntity: Environment %lu does "
+                         "not exist",
+                         env);
+                throw BatchedWorldException(buf);
+            }
+            if (_free_entities[env].empty()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "BatchedWorld::createEntity: Environment %lu is full "
+                         "(capacity: %lu)",
+                         env, _capacity);
+                throw BatchedWorldException(buf);
+            }
+            const BatchEntity e = _free_entities[env].back();
+
+            _free_entities[env].pop_back();
+            _alive[slotOf(env, e)] = 1;
+            return e;
+        }
+
+        void BatchedWorld::removeEntity(size_t env, BatchEntity e)
+        {
+            const size_t slot = __getSlot(env, e);
+
+            for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                if (_signatures[slot].test(i)) {
+                    _columns[i]->reset(slot);
+                }
+            }
+            _signatures[slot].reset();
+            _alive[slot] = 0;
+            _free_entities[env].push_back(e);
+            _masks_dirty = true;
+        }
+
+        void BatchedWorld::resetEnvironment(size_t env)
+        {
+            if (env >= _environments) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "BatchedWorld::resetEnvironment: Environment %lu "
+                         "does not exist",
+                         env);
+                throw BatchedWorldException(buf);
+            }
+            // Walk backward so the entities are handed out again from 0, as
+            // in a fresh environment
+            for (BatchEntity e = _capacity; e != 0; e--) {
+                if (_alive[slotOf(env, e - 1)] != 0) {
+                    removeEntity(env, e - 1);
+                }
+            }
+        }
+
+        std::span<const ComponentSignature> BatchedWorld::signatures(
+            void) const
+        {
+            return std::span<const ComponentSignature>(_signatures);
+        }
+
+        void BatchedWorld::registerSystem(const BatchedSystem &sys)
+        {
+            if (sys.getSignature() == 0) {
+                throw BatchedWorldException(
+                    "BatchedWorld::registerSystem: System signature is 0");
+            }
+            for (const auto &it : _systems) {
+                if (it.system.getTag() == sys.getTag()) {
+                    std::string err =
+                        "BatchedWorld::registerSystem: A system with tag: \"";
+                    err += sys.getTag() + "\" already exists";
+                    throw BatchedWorldException(err);
+                }
+            }
+            _systems.push_back({ sys, std::vector<uint8_t>(slots(), 0) });
+            _masks_dirty = true;
+        }
+
+        void BatchedWorld::removeSystem(const std::string &tag)
+        {
+            const auto it = std::find_if(
+                _systems.begin(), _systems.end(),
+                [&](SystemEntry &s) { return s.system.getTag() == tag; });
+
+            if (it == _systems.end()) {
+                std::string err =
+                    "BatchedWorld::removeSystem: Cannot find system with "
+                    "tag: \"";
+                err += tag + "\"";
+                throw BatchedWorldException(err);
+            }
+            _systems.erase(it);
+        }
+
+        void BatchedWorld::__updateMasks(void)
+        {
+            for (auto &it : _systems) {
+                const ComponentSignature &signature = it.system.getSignature();
+
+                for (size_t slot = 0; slot != _signatures.size(); slot++) {
+                    it.mask[slot] =
+                        isValidSignature(_signatures[slot], signature);
+                }
+            }
+            _masks_dirty = false;
+        }
+
+        void BatchedWorld::updateSystem(void)
+        {
+            if (_masks_dirty) {
+                __updateMasks();
+            }
+            for (const auto &it : _systems) {
+                it.system.onUpdate(*this, it.mask);
+            }
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,284 @@
+/**
+ * src/ecs/ComponentPool/ComponentPool.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/ComponentPool/ComponentPool.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        ComponentPool::ComponentPool(std::pmr::memory_resource *resource)
+            : _resource(resource)
+            , _present(resource)
+            , _packed(resource)
+            , _sparse(resource)
+            , _pages(resource)
+        {
+        }
+
+        ComponentPool::ComponentPool(ComponentPool &&other) noexcept
+            : _resource(other._resource)
+            , _storage(other._storage)
+            , _vtable(other._vtable)
+            , _values(other._values)
+            , _capacity(other._capacity)
+            , _size(other._size)
+            , _present(std::move(other._present))
+            , _packed(std::move(other._packed))
+            , _sparse(std::move(other._sparse))
+            , _pages(std::move(other._pages))
+        {
+            other._values   = nullptr;
+            other._capacity = 0;
+            other._size     = 0;
+        }
+
+        ComponentPool &ComponentPool::operator=(ComponentPool &&other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ComponentPool::~ComponentPool(void)
+        {
+            clear();
+        }
+
+        void ComponentPool::configure(ComponentStorage storage,
+                                      const ComponentVTable *vtable)
+        {
+            _storage = storage;
+            _vtable  = vtable;
+        }
+
+        ComponentStorage ComponentPool::getStorage(void) const
+        {
+            return _storage;
+        }
+
+        const ComponentVTable *ComponentPool::getVTable(void) const
+        {
+            return _vtable;
+        }
+
+        size_t ComponentPool::size(void) const
+        {
+            return _size;
+        }
+
+        EntityIndex &ComponentPool::__makePosition(EntityIndex index)
+        {
+            if (_storage == ComponentStorage::Sparse) {
+                if (index >= _sparse.size()) {
+                    _sparse.resize(size_t(index) + 1, npos);
+                }
+                return _sparse[index];
+            }
+            const size_t page = index / VAZEL_COMPONENT_PAGE_SIZE;
+
+            if (page >= _pages.size()) {
+                _pages.resize(page + 1, nullptr);
+            }
+            if (_pages[page] == nullptr) {
+                EntityIndex *positions =
+                    static_cast<EntityIndex *>(_resource->allocate(
+                        VAZEL_COMPONENT_PAGE_SIZE * sizeof(EntityIndex),
+                        alignof(EntityIndex)));
+
+                std::fill_n(positions, VAZEL_COMPONENT_PAGE_SIZE, npos);
+                _pages[page] = positions;
+            }
+            return _pages[page][index % VAZEL_COMPONENT_PAGE_SIZE];
+        }
+
+        void ComponentPool::__reserve(size_t capacity)
+        {
+            const size_t size = _vtable->size;
+
+            if (_storage != ComponentStorage::Dense) {
+                _packed.reserve(capacity);
+            }
+            std::byte *values = static_cast<std::byte *>(
+                _resource->allocate(capacity * size, _vtable->align));
+
+            if (_storage == ComponentStorage::Dense) {
+                _present.forEach([&](size_t index) {
+                    _vtable->relocate(values + index * size, __at(index));
+                });
+            } else {
+                for (size_t i = 0; i != _size; i++) {
+                    _vtable->relocate(values + i * size, __at(i));
+                }
+            }
+            if (_values != nullptr) {
+                _resource->deallocate(_values, _capacity * size,
+                                      _vtable->align);
+            }
+            _values   = values;
+            _capacity = capacity;
+        }
+
+        void *ComponentPool::__prepare(EntityIndex index)
+        {
+            if (_storage == ComponentStorage::Dense) {
+                if (index >= _capacity) {
+                    __reserve(std::max<size_t>(
+                        { 8, size_t(index) + 1, _capacity * 2 }));
+                }
+                return __at(index);
+            }
+            __makePosition(index);
+            if (_size == _capacity) {
+                __reserve(std::max<size_t>(8, _capacity * 2));
+            }
+            return __at(_size);
+        }
+
+        void ComponentPool::__commit(EntityIndex index)
+        {
+            if (_storage == ComponentStorage::Dense) {
+                _present.set(index);
+            } else {
+                __makePosition(index) = static_cast<EntityIndex>(_size);
+                _packed.push_back(index);
+            }
+            _size++;
+        }
+
+        bool ComponentPool::__holds(const void *address) const
+        {
+            const std::less<const void *> less;
+
+            return !less(address, _values) &&
+                   less(address, _values + _capacity * _vtable->size);
+        }
+
+        bool ComponentPool::contains(EntityIndex index) const
+        {
+            return find(index) != nullptr;
+        }
+
+        bool ComponentPool::erase(EntityIndex index)
+        {
+            if (_storage == ComponentStorage::Dense) {
+                if (_present.test(index) == false) {
+                    return false;
+                }
+                _vtable->destroy(__at(index));
+                _present.reset(index);
+                _size--;
+                return true;
+            }
+            EntityIndex *position = __position(index);
+
+            if (position == nullptr || *position == npos) {
+                return false;
+            }
+            const EntityIndex slot = *position;
+            const size_t last      = _size - 1;
+
+            _vtable->destroy(__at(slot));
+            *position = npos;
+            // The last value fills the hole to keep the values packed
+            if (slot != last) {
+                _vtable->relocate(__at(slot), __at(last));
+                _packed[slot]              = _packed[last];
+                *__position(_packed[slot]) = slot;
+            }
+            _packed.pop_back();
+            _size--;
+            return true;
+        }
+
+        void ComponentPool::clear(void)
+        {
+            if (_values != nullptr) {
+                if (_storage == ComponentStorage::Dense) {
+                    _present.forEach([this](size_t index) {
+                        _vtable->destroy(__at(index));
+                    });
+                } else {
+                    for (size_t i = 0; i != _size; i++) {
+                        _vtable->destroy(__at(i));
+                    }
+                }
+                _resource->deallocate(_values, _capacity * _vtable->size,
+                                      _vtable->align);
+            }
+            for (EntityIndex *it : _pages) {
+                if (it != nullptr) {
+                    _resource->deallocate(
+                        it, VAZEL_COMPONENT_PAGE_SIZE * sizeof(EntityIndex),
+                        alignof(EntityIndex));
+                }
+            }
+            _values   = nullptr;
+            _capacity = 0;
+            _size     = 0;
+            _present  = HierarchicalBitset(_resource);
+            _packed   = std::pmr::vector<EntityIndex>(_resource);
+            _sparse   = std::pmr::vector<EntityIndex>(_resource);
+            _pages    = std::pmr::vector<EntityIndex *>(_resource);
+        }
+
+        void ComponentPool::swap(ComponentPool &other)
+        {
+            std::swap(_resource, other._resource);
+            std::swap(_storage, other._storage);
+            std::swap(_vtable, other._vtable);
+            std::swap(_values, other._values);
+            std::swap(_capacity, other._capacity);
+            std::swap(_size, other._size);
+            _present.swap(other._present);
+            _packed.swap(other._packed);
+            _sparse.swap(other._sparse);
+            _pages.swap(other._pages);
+        }
+
+        size_t ComponentPool::getValueBytes(void) const
+        {
+            return _vtable != nullptr ? _capacity * _vtable->size : 0;
+        }
+
+        size_t ComponentPool::getIndexBytes(void) const
+        {
+            size_t bytes = (_packed.capacity() + _sparse.capacity()) *
+                               sizeof(EntityIndex) +
+                           _pages.capacity() * sizeof(EntityIndex *);
+
+            for (const EntityIndex *it : _pages) {
+                if (it != nullptr) {
+                    bytes += VAZEL_COMPONENT_PAGE_SIZE * sizeof(EntityIndex);
+                }
+            }
+            if (_storage == ComponentStorage::Dense) {
+                // The presence bits, the summary levels are negligible
+                bytes += (_capacity + 7) / 8;
+            }
+            return bytes;
+        }
+
+    } // namespace ecs
+} // namespace vazel
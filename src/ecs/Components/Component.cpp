@@ -22,27 +22,6 @@ namespace vazel
     namespace ecs
     {
 
-        void Component::remove(void)
-        {
-            _data.reset();
-        }
-
-        Component::~Component(void)
-        {
-            remove();
-        }
-
-        ComponentExistsException::ComponentExistsException(
-            const std::string &e)
-            : _e(e)
-        {
-        }
-
-        const char *ComponentExistsException::what(void) const throw()
-        {
-            return _e.c_str();
-        }
-
         bool isValidSignature(const ComponentSignature &signature,
                               const ComponentSignature &to_match)
         {
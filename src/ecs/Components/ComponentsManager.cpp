@@ -22,6 +22,28 @@ namespace vazel
     namespace ecs
     {
 
+        ComponentManager::ComponentManager(std::pmr::memory_resource *resource)
+            : _own_entities(std::make_unique<EntityManager>(resource))
+            , _entities(_own_entities.get())
+            , _resource(resource)
+        {
+            _pools.reserve(VAZEL_MAX_COMPONENTS);
+            for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                _pools.emplace_back(resource);
+            }
+        }
+
+        ComponentManager::ComponentManager(const EntityManager &entities,
+                                           std::pmr::memory_resource *resource)
+            : _entities(&entities)
+            , _resource(resource)
+        {
+            _pools.reserve(VAZEL_MAX_COMPONENTS);
+            for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                _pools.emplace_back(resource);
+            }
+        }
+
         ComponentType ComponentManager::_getAviableComponentIndex(void)
         {
             for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
@@ -45,6 +67,25 @@ namespace vazel
             return _aviable_signatures;
         }
 
+        const ComponentPool &ComponentManager::getPool(
+            ComponentType type) const
+        {
+            return _pools.at(type);
+        }
+
+        size_t ComponentManager::getComponentCount(ComponentType type) const
+        {
+            return type < VAZEL_MAX_COMPONENTS ? _pools[type].size() : 0;
+        }
+
+        void *ComponentManager::__find(ComponentType type,
+                                       const Entity &e) const
+        {
+            const EntityIndex *index = _entities->findIndex(e);
+
+            return index != nullptr ? _pools[type].find(*index) : nullptr;
+        }
+
         std::ostream &operator<<(std::ostream &os,
                                  const ComponentManager &cManager)
         {
@@ -83,40 +124,70 @@ namespace vazel
 
         void ComponentManager::onEntityCreate(const Entity &e)
         {
-            if (_entity_to_components.find(e) != _entity_to_components.end()) {
+            const bool known = _entities->findIndex(e) != nullptr;
+
+            if (known == (_own_entities != nullptr)) {
                 char buf[BUFSIZ] = { 0 };
                 std::snprintf(buf, sizeof(buf) - 1,
                               "ComponenentManager::onEntityCreate: "
-                              "Entity(%lu) is already registered"
-                              " in the _entity_to_components map",
-                              e.getId());
+                              "Entity(%lu) is %s",
+                              e.getId(),
+                              known ? "already registered"
+                                    : "not in the shared EntityManager");
                 throw ComponentManagerException(std::string(buf));
             }
-            _entity_to_components.emplace(e, ComponentArray());
+            if (_own_entities != nullptr) {
+                _own_entities->setSignature(e, ComponentSignature());
+            }
         }
 
         void ComponentManager::onEntityDestroy(const Entity &e)
         {
-            const auto &it = _entity_to_components.find(e);
+            const EntityIndex *index = _entities->findIndex(e);
 
-            if (it == _entity_to_components.end()) {
+            if (index == nullptr) {
                 char buf[BUFSIZ] = { 0 };
                 std::snprintf(buf, sizeof(buf) - 1,
-                              "ComponenentManager::onEntityCreate: "
+                              "ComponenentManager::onEntityDestroy: "
                               "Entity(%lu) is not registered in "
-                              "the _entity_to_components map",
+                              "the EntityManager",
                               e.getId());
                 throw ComponentManagerException(std::string(buf));
             }
-            _entity_to_components.erase(it->first);
+            for (ComponentType i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                if (_aviable_signatures.test(i)) {
+                    _pools[i].erase(*index);
+                }
+            }
+            if (_own_entities != nullptr) {
+                Entity entity = e;
+
+                _own_entities->destroyEntity(entity);
+            }
         }
 
         void ComponentManager::clear(void)
         {
             _components_map.clear();
-            _entity_to_components.clear();
+            if (_own_entities != nullptr) {
+                _own_entities->clear();
+            }
+            for (auto &it : _pools) {
+                it.clear();
+            }
             _aviable_signatures = 0;
         }
 
+        void ComponentManager::swap(ComponentManager &other)
+        {
+            if (_own_entities != nullptr || other._own_entities != nullptr) {
+                std::swap(_entities, other._entities);
+                std::swap(_own_entities, other._own_entities);
+            }
+            std::swap(_components_map, other._components_map);
+            std::swap(_aviable_signatures, other._aviable_signatures);
+            _pools.swap(other._pools);
+        }
+
     } // namespace ecs
 } // namespace vazel
@@ -38,54 +38,176 @@ namespace vazel
         {
         }
 
+        EntityManager::EntityManager(std::pmr::memory_resource *resource)
+            : _entity_map(resource)
+            , _index_entities(resource)
+            , _free_indices(resource)
+            , _alive(resource)
+            , _dirty(resource)
+        {
+            _component_sets.reserve(VAZEL_MAX_COMPONENTS);
+            for (size_t i = 0; i != VAZEL_MAX_COMPONENTS; i++) {
+                _component_sets.emplace_back(resource);
+            }
+        }
+
+        EntityRecord &EntityManager::__getRecord(const Entity &e,
+                                                 const char *caller)
+        {
+            return const_cast<EntityRecord &>(
+                static_cast<const EntityManager *>(this)->__getRecord(
+                    e, caller));
+        }
+
+        const EntityRecord &EntityManager::__getRecord(
+            const Entity &e, const char *caller) const
+        {
+            const auto it = _entity_map.find(e);
+
+            if (it == _entity_map.end()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "EntityManager::%s: Entity %lu does not exist",
+                         caller, e.getId());
+                throw EntityManagerExceptionFindEntityError(buf);
+            }
+            return it->second;
+        }
+
+        void EntityManager::__indexSignature(
+            EntityIndex index, const ComponentSignature &signature)
+        {
+            for (ComponentType c = 0; c != VAZEL_MAX_COMPONENTS; c++) {
+                if (signature.test(c)) {
+                    _component_sets[c].set(index);
+                } else {
+                    _component_sets[c].reset(index);
+                }
+            }
+        }
+
+        void EntityManager::__sync(void)
+        {
+            if (_dirty.empty()) {
+                return;
+            }
+            _dirty.forEach([this](size_t index) {
+                __indexSignature(
+                    index, _entity_map.at(_index_entities[index]).signature);
+            });
+            _dirty.clear();
+        }
+
+        EntityRecord &EntityManager::__insert(const Entity &e)
+        {
+            EntityIndex index;
+
+            if (_free_indices.empty()) {
+                index = _index_entities.size();
+                _index_entities.push_back(e);
+            } else {
+                index = _free_indices.back();
+                _free_indices.pop_back();
+                _index_entities[index] = e;
+            }
+            _alive.set(index);
+            return _entity_map[e] =
+                       EntityRecord { ComponentSignature(), index };
+        }
+
         Entity EntityManager::createEntity(void)
         {
             Entity e = Entity();
 
-            _entity_map[e] = ComponentSignature();
+            __insert(e);
             return e;
         }
 
         void EntityManager::destroyEntity(Entity &e)
         {
-            if (_entity_map.find(e) == _entity_map.end()) {
-                char buf[BUFSIZ] = { 0 };
-                snprintf(
-                    buf, sizeof(buf) - 1,
-                    "EntityManager::destroyEntity: Entity %lu does not exist",
-                    e.getId());
-                throw EntityManagerExceptionFindEntityError(buf);
-            }
+            const EntityIndex index = __getRecord(e, "destroyEntity").index;
+
+            __indexSignature(index, ComponentSignature());
+            _alive.reset(index);
+            _dirty.reset(index);
+            _free_indices.push_back(index);
             _entity_map.erase(e);
-            return;
         }
 
         void EntityManager::setSignature(const Entity &e,
                                          const ComponentSignature &signature)
         {
-            try {
-                _entity_map[e] = signature;
-                return;
-            } catch (...) {
-                char buf[BUFSIZ] = { 0 };
-                snprintf(buf, sizeof(buf) - 1,
-                         "EntityManager::setSignature: %lu does not exist",
-                         e.getId());
-                throw EntityManagerExceptionFindEntityError(buf);
+            const auto it        = _entity_map.find(e);
+            EntityRecord &record =
+                it != _entity_map.end() ? it->second : __insert(e);
+
+            record.signature = signature;
+            __indexSignature(record.index, signature);
+        }
+
+        void EntityManager::setComponent(const Entity &e, ComponentType type,
+                                         bool attached)
+        {
+            EntityRecord &record = __getRecord(e, "setComponent");
+
+            record.signature.set(type, attached);
+            if (attached) {
+                _component_sets[type].set(record.index);
+            } else {
+                _component_sets[type].reset(record.index);
             }
         }
 
         ComponentSignature &EntityManager::getSignature(const Entity &e)
         {
-            try {
-                return _entity_map[e];
-            } catch (...) {
-                char buf[BUFSIZ] = { 0 };
-                snprintf(buf, sizeof(buf) - 1,
-                         "EntityManager::getSignature: %lu does not exist",
-                         e.getId());
-                throw EntityManagerExceptionFindEntityError(buf);
+            const auto it        = _entity_map.find(e);
+            EntityRecord &record =
+                it != _entity_map.end() ? it->second : __insert(e);
+
+            _dirty.set(record.index);
+            return record.signature;
+        }
+
+        const ComponentSignature &EntityManager::getSignature(
+            const Entity &e) const
+        {
+            return __getRecord(e, "getSignature").signature;
+        }
+
+        EntityIndex EntityManager::getIndex(const Entity &e) const
+        {
+            return __getRecord(e, "getIndex").index;
+        }
+
+        const EntityIndex *EntityManager::findIndex(const Entity &e) const
+        {
+            const auto it = _entity_map.find(e);
+
+            return it != _entity_map.end() ? &it->second.index : nullptr;
+        }
+
+        size_t EntityManager::getIndexCount(void) const
+        {
+            return _index_entities.size();
+        }
+
+        size_t EntityManager::getIndexBytes(void) const
+        {
+            size_t bytes = _index_entities.capacity() * sizeof(Entity) +
+                           _free_indices.capacity() * sizeof(EntityIndex) +
+                           _alive.getBytes() + _dirty.getBytes();
+
+            for (const auto &it : _component_sets) {
+                bytes += it.getBytes();
             }
+            return bytes;
+        }
+
+        const HierarchicalBitset &EntityManager::getComponentSet(
+            ComponentType type)
+        {
+            __sync();
+            return _component_sets[type];
         }
 
         const EntityMap &EntityManager::getMap(void) const
@@ -96,6 +218,23 @@ namespace vazel
         void EntityManager::clear(void)
         {
             _entity_map.clear();
+            _index_entities.clear();
+            _free_indices.clear();
+            _alive.clear();
+            _dirty.clear();
+            for (auto &it : _component_sets) {
+                it.clear();
+            }
+        }
+
+        void EntityManager::swap(EntityManager &other)
+        {
+            std::swap(_entity_map, other._entity_map);
+            std::swap(_index_entities, other._index_entities);
+            std::swap(_free_indices, other._free_indices);
+            _alive.swap(other._alive);
+            _dirty.swap(other._dirty);
+            std::swap(_component_sets, other._component_sets);
         }
 
     } // namespace ecs
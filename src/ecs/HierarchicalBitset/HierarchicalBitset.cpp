@@ -0,0 +1,110 @@
+/**
+ * src/ecs/HierarchicalBitset/HierarchicalBitset.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp"
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        HierarchicalBitset::HierarchicalBitset(
+            std::pmr::memory_resource *resource)
+            : _bits(resource)
+            , _blocks(resource)
+            , _regions(resource)
+        {
+        }
+
+        void HierarchicalBitset::set(size_t index)
+        {
+            const size_t w = index / 64;
+            const size_t b = w / 64;
+            const size_t r = b / 64;
+
+            if (w >= _bits.size()) {
+                _bits.resize(w + 1);
+                _blocks.resize(b + 1);
+                _regions.resize(r + 1);
+            }
+            _bits[w] |= uint64_t(1) << (index % 64);
+            _blocks[b] |= uint64_t(1) << (w % 64);
+            _regions[r] |= uint64_t(1) << (b % 64);
+        }
+
+        void HierarchicalBitset::reset(size_t index)
+        {
+            const size_t w = index / 64;
+            const size_t b = w / 64;
+
+            if (w >= _bits.size()) {
+                return;
+            }
+            _bits[w] &= ~(uint64_t(1) << (index % 64));
+            // The summaries only keep the bits of the words not empty
+            if (_bits[w] != 0) {
+                return;
+            }
+            _blocks[b] &= ~(uint64_t(1) << (w % 64));
+            if (_blocks[b] == 0) {
+                _regions[b / 64] &= ~(uint64_t(1) << (b % 64));
+            }
+        }
+
+        size_t HierarchicalBitset::count(void) const
+        {
+            size_t count = 0;
+
+            for (size_t b = 0; b != _blocks.size(); b++) {
+                for (uint64_t block = _blocks[b]; block != 0;
+                     block &= block - 1) {
+                    count += std::popcount(
+                        _bits[b * 64 + std::countr_zero(block)]);
+                }
+            }
+            return count;
+        }
+
+        bool HierarchicalBitset::empty(void) const
+        {
+            return std::all_of(_regions.begin(), _regions.end(),
+                               [](uint64_t region) { return region == 0; });
+        }
+
+        void HierarchicalBitset::clear(void)
+        {
+            std::fill(_bits.begin(), _bits.end(), 0);
+            std::fill(_blocks.begin(), _blocks.end(), 0);
+            std::fill(_regions.begin(), _regions.end(), 0);
+        }
+
+        void HierarchicalBitset::swap(HierarchicalBitset &other)
+        {
+            std::swap(_bits, other._bits);
+            std::swap(_blocks, other._blocks);
+            std::swap(_regions, other._regions);
+        }
+
+        size_t HierarchicalBitset::getBytes(void) const
+        {
+            return (_bits.capacity() + _blocks.capacity() +
+                    _regions.capacity()) *
+                   sizeof(uint64_t);
+        }
+
+    } // namespace ecs
+} // namespace vazel
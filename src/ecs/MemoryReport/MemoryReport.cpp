@@ -0,0 +1,153 @@
+/**
+ * src/ecs/MemoryReport/MemoryReport.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/MemoryReport/MemoryReport.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        size_t ComponentMemory::reservedBytes(void) const
+        {
+            return heapBytes + slotBytes;
+        }
+
+        double ComponentMemory::overheadPerInstance(void) const
+        {
+            if (instances == 0) {
+                return 0;
+            }
+            return static_cast<double>(reservedBytes() - payloadBytes) /
+                   instances;
+        }
+
+        double ComponentMemory::fragmentation(void) const
+        {
+            const size_t reserved = reservedBytes();
+
+            return reserved ? 1 - static_cast<double>(payloadBytes) / reserved
+                            : 0;
+        }
+
+        size_t MemoryReport::totalBytes(void) const
+        {
+            size_t total = entities.reservedBytes + entityIndex.reservedBytes;
+
+            for (const auto &it : components) {
+                total += it.reservedBytes();
+            }
+            for (const auto &it : systems) {
+                total += it.reservedBytes;
+            }
+            return total;
+        }
+
+        size_t allocationFootprint(size_t size, size_t align,
+                                   std::pmr::memory_resource *resource)
+        {
+            if (resource == std::pmr::new_delete_resource()) {
+                // malloc: a 8 bytes header, 16 bytes chunks, 32 bytes minimum
+                return std::max<size_t>(32, (size + 8 + 15) & ~size_t(15));
+            }
+            // Pools round the size to the alignment
+            return (size + align - 1) / align * align;
+        }
+
+        std::vector<ComponentMemory> measureComponents(
+            const ComponentManager &cm, std::pmr::memory_resource *resource)
+        {
+            std::vector<ComponentMemory> components;
+
+            for (const auto &it : cm.getComponentMap()) {
+                const ComponentPool &pool     = cm.getPool(it.second);
+                const ComponentVTable *vtable = pool.getVTable();
+                ComponentMemory memory;
+
+                memory.name      = it.first;
+                memory.type      = it.second;
+                memory.instances = pool.size();
+                memory.slotBytes = pool.getIndexBytes();
+                if (vtable != nullptr) {
+                    memory.instanceSize = vtable->size;
+                    memory.payloadBytes = memory.instances * vtable->size;
+                }
+                if (pool.getValueBytes() != 0) {
+                    memory.heapBytes = allocationFootprint(
+                        pool.getValueBytes(), vtable->align, resource);
+                }
+                components.push_back(memory);
+            }
+            std::sort(components.begin(), components.end(),
+                      [](const ComponentMemory &a, const ComponentMemory &b) {
+                          return a.type < b.type;
+                      });
+            return components;
+        }
+
+        std::ostream &operator<<(std::ostream &os, const MemoryReport &report)
+        {
+            char buf[BUFSIZ];
+
+            snprintf(buf, sizeof(buf), "%-32s %10s %8s %12s %12s %10s %6s\n",
+                     "component", "instances", "size", "payload",
+                     "reserved", "overhead", "frag");
+            os << buf;
+            for (const auto &it : report.components) {
+                snprintf(buf, sizeof(buf),
+                         "%-32.32s %10zu %8zu %12zu %12zu %10.1f %5.1f%%\n",
+                         it.name.c_str(), it.instances, it.instanceSize,
+                         it.payloadBytes, it.reservedBytes(),
+                         it.overheadPerInstance(), it.fragmentation() * 100);
+                os << buf;
+            }
+            snprintf(buf, sizeof(buf), "\n%-32s %10s %12s %12s\n",
+                     "container", "elements", "used", "reserved");
+            os << buf;
+
+            std::vector<const ContainerMemory *> containers = {
+                &report.entities, &report.entityIndex
+            };
+            for (const auto &it : report.systems) {
+                containers.push_back(&it);
+            }
+            for (const auto *it : containers) {
+                snprintf(buf, sizeof(buf), "%-32.32s %10zu %12zu %12zu\n",
+                         it->name.c_str(), it->elements, it->usedBytes,
+                         it->reservedBytes);
+                os << buf;
+            }
+            snprintf(buf, sizeof(buf), "\ntotal (estimated) %zu bytes\n",
+                     report.totalBytes());
+            os << buf;
+            if (report.arenaReserved != 0) {
+                snprintf(buf, sizeof(buf),
+                         "arena %zu bytes allocated, %zu reserved "
+                         "(%.1f%% unused)\n",
+                         report.arenaAllocated, report.arenaReserved,
+                         100 - 100.0 * report.arenaAllocated /
+                                   report.arenaReserved);
+                os << buf;
+            }
+            return os;
+        }
+
+    } // namespace ecs
+} // namespace vazel
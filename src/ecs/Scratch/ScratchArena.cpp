@@ -0,0 +1,104 @@
+/**
+ * src/ecs/Scratch/ScratchArena.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/Scratch/ScratchArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        ScratchArena::ScratchArena(size_t blockSize)
+            : _block_size(blockSize)
+        {
+        }
+
+        void ScratchArena::reset(void)
+        {
+            for (auto &it : _slots) {
+                it.current = 0;
+                it.offset  = 0;
+                it.used    = 0;
+            }
+        }
+
+        size_t ScratchArena::getUsed(void) const
+        {
+            size_t used = 0;
+
+            for (const auto &it : _slots) {
+                used += it.used;
+            }
+            return used;
+        }
+
+        size_t ScratchArena::getReserved(void) const
+        {
+            size_t reserved = 0;
+
+            for (const auto &it : _slots) {
+                for (const auto &block : it.blocks) {
+                    reserved += block.size;
+                }
+            }
+            return reserved;
+        }
+
+        void *ScratchArena::do_allocate(size_t bytes, size_t align)
+        {
+            Slot &slot = _slots[threadSlot()];
+
+            while (slot.current < slot.blocks.size()) {
+                Block &block          = slot.blocks[slot.current];
+                const uintptr_t start =
+                    reinterpret_cast<uintptr_t>(block.data.get());
+                const uintptr_t aligned =
+                    (start + slot.offset + align - 1) & ~(align - 1);
+
+                if (aligned + bytes <= start + block.size) {
+                    slot.offset = aligned + bytes - start;
+                    slot.used += bytes;
+                    return reinterpret_cast<void *>(aligned);
+                }
+                slot.current++;
+                slot.offset = 0;
+            }
+            // Blocks are kept once allocated, so this only happens while
+            // warming up or when a frame needs more than ever before
+            const size_t size = std::max(_block_size, bytes + align);
+
+            slot.blocks.push_back(
+                { std::make_unique<std::byte[]>(size), size });
+            slot.current = slot.blocks.size() - 1;
+            return do_allocate(bytes, align);
+        }
+
+        void ScratchArena::do_deallocate(void *, size_t, size_t)
+        {
+        }
+
+        bool ScratchArena::do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept
+        {
+            return this == &other;
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,281 @@
+/**
+ * src/ecs/Spatial/SpatialGrid.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/Spatial/SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        SpatialGridException::SpatialGridException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *SpatialGridException::what(void) const throw()
+        {
+            return _e.c_str();
+        }
+
+        SpatialGrid::SpatialGrid(float cellSize)
+            : _cell_size(cellSize)
+        {
+            if (!(cellSize > 0)) {
+                throw SpatialGridException(
+                    "SpatialGrid::SpatialGrid: The cell size must be "
+                    "positive");
+            }
+        }
+
+        int32_t SpatialGrid::__cellCoord(float v) const
+        {
+            return static_cast<int32_t>(std::floor(v / _cell_size));
+        }
+
+        uint64_t SpatialGrid::__cellKey(int32_t cx, int32_t cy)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+                   static_cast<uint32_t>(cy);
+        }
+
+        void SpatialGrid::__eraseFromCell(uint64_t cell, const Entity &e)
+        {
+            auto it     = _cells.find(cell);
+            auto &items = it->second;
+
+            for (size_t i = 0; i != items.size(); i++) {
+                if (items[i].entity == e) {
+                    items[i] = items.back();
+                    items.pop_back();
+                    break;
+                }
+            }
+            if (items.empty()) {
+                _cells.erase(it);
+            }
+        }
+
+        void SpatialGrid::__relocate(const Entity &e, Tracked &tracked,
+                                     const SpatialPoint &position)
+        {
+            if (tracked.position.x == position.x &&
+                tracked.position.y == position.y) {
+                return;
+            }
+            const uint64_t cell = __cellKey(__cellCoord(position.x),
+                                            __cellCoord(position.y));
+
+            tracked.position = position;
+            if (cell == tracked.cell) {
+                for (auto &item : _cells[cell]) {
+                    if (item.entity == e) {
+                        item.position = position;
+                        break;
+                    }
+                }
+                return;
+            }
+            __eraseFromCell(tracked.cell, e);
+            tracked.cell = cell;
+            _cells[cell].push_back({ e, position });
+        }
+
+        float SpatialGrid::getCellSize(void) const
+        {
+            return _cell_size;
+        }
+
+        size_t SpatialGrid::size(void) const
+        {
+            return _entities.size();
+        }
+
+        bool SpatialGrid::contains(const Entity &e) const
+        {
+            return _entities.find(e) != _entities.end();
+        }
+
+        void SpatialGrid::insert(const Entity &e, const SpatialPoint &position)
+        {
+            const uint64_t cell = __cellKey(__cellCoord(position.x),
+                                            __cellCoord(position.y));
+
+            if (_entities.emplace(e, Tracked { cell, position }).second ==
+                false) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "SpatialGrid::insert: Entity %lu is already indexed",
+                         e.getId());
+                throw SpatialGridException(buf);
+            }
+            _cells[cell].push_back({ e, position });
+        }
+
+        void SpatialGrid::move(const Entity &e, const SpatialPoint &position)
+        {
+            const auto it = _entities.find(e);
+
+            if (it == _entities.end()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "SpatialGrid::move: Entity %lu is not indexed",
+                         e.getId());
+                throw SpatialGridException(buf);
+            }
+            __relocate(e, it->second, position);
+        }
+
+        void SpatialGrid::remove(const Entity &e)
+        {
+            const auto it = _entities.find(e);
+
+            if (it == _entities.end()) {
+                char buf[BUFSIZ] = { 0 };
+                snprintf(buf, sizeof(buf) - 1,
+                         "SpatialGrid::remove: Entity %lu is not indexed",
+                         e.getId());
+                throw SpatialGridException(buf);
+            }
+            __eraseFromCell(it->second.cell, e);
+            _entities.erase(it);
+        }
+
+        void SpatialGrid::clear(void)
+        {
+            _cells.clear();
+            _entities.clear();
+        }
+
+        void SpatialGrid::refresh(
+            const std::function<SpatialPoint(const Entity &)> &position)
+        {
+            for (auto &it : _entities) {
+                __relocate(it.first, it.second, position(it.first));
+            }
+        }
+
+        void SpatialGrid::queryRadius(const SpatialPoint &center, float radius,
+                                      std::vector<Entity> &out) const
+        {
+            const float radius2 = radius * radius;
+            const int32_t minx  = __cellCoord(center.x - radius);
+            const int32_t maxx  = __cellCoord(center.x + radius);
+            const int32_t miny  = __cellCoord(center.y - radius);
+            const int32_t maxy  = __cellCoord(center.y + radius);
+
+            for (int32_t cx = minx; cx <= maxx; cx++) {
+                for (int32_t cy = miny; cy <= maxy; cy++) {
+                    const auto it = _cells.find(__cellKey(cx, cy));
+
+                    if (it == _cells.end()) {
+                        continue;
+                    }
+                    for (const auto &item : it->second) {
+                        const float dx = item.position.x - center.x;
+                        const float dy = item.position.y - center.y;
+
+                        if (dx * dx + dy * dy <= radius2) {
+                            out.push_back(item.entity);
+                        }
+                    }
+                }
+            }
+        }
+
+        void SpatialGrid::queryAABB(const SpatialPoint &min,
+                                    const SpatialPoint &max,
+                                    std::vector<Entity> &out) const
+        {
+            for (int32_t cx = __cellCoord(min.x); cx <= __cellCoord(max.x);
+                 cx++) {
+                for (int32_t cy = __cellCoord(min.y);
+                     cy <= __cellCoord(max.y); cy++) {
+                    const auto it = _cells.find(__cellKey(cx, cy));
+
+                    if (it == _cells.end()) {
+                        continue;
+                    }
+                    for (const auto &item : it->second) {
+                        if (item.position.x >= min.x &&
+                            item.position.x <= max.x &&
+                            item.position.y >= min.y &&
+                            item.position.y <= max.y) {
+                            out.push_back(item.entity);
+                        }
+                    }
+                }
+            }
+        }
+
+        void SpatialGrid::forEachPair(float radius,
+                                      const spatialPairCallback &fn) const
+        {
+            const float radius2 = radius * radius;
+            const int32_t range =
+                static_cast<int32_t>(std::ceil(radius / _cell_size));
+
+            for (const auto &cell : _cells) {
+                const int32_t cx = static_cast<int32_t>(cell.first >> 32);
+                const int32_t cy = static_cast<int32_t>(cell.first);
+                const auto &items = cell.second;
+
+                for (size_t i = 0; i != items.size(); i++) {
+                    for (size_t j = i + 1; j != items.size(); j++) {
+                        const float dx =
+                            items[i].position.x - items[j].position.x;
+                        const float dy =
+                            items[i].position.y - items[j].position.y;
+
+                        if (dx * dx + dy * dy <= radius2) {
+                            fn(items[i].entity, items[j].entity);
+                        }
+                    }
+                }
+                // Only visit half of the neighbourhood so every pair of
+                // cells is considered once
+                for (int32_t ox = -range; ox <= range; ox++) {
+                    for (int32_t oy = 0; oy <= range; oy++) {
+                        if (oy == 0 && ox <= 0) {
+                            continue;
+                        }
+                        const auto other = _cells.find(__cellKey(cx + ox,
+                                                                 cy + oy));
+
+                        if (other == _cells.end()) {
+                            continue;
+                        }
+                        for (const auto &a : items) {
+                            for (const auto &b : other->second) {
+                                const float dx = a.position.x - b.position.x;
+                                const float dy = a.position.y - b.position.y;
+
+                                if (dx * dx + dy * dy <= radius2) {
+                                    fn(a.entity, b.entity);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Vazel/ecs/System/System.hpp"
+#include "Vazel/profiling/Trace/Trace.hpp"
 
 namespace vazel
 {
@@ -28,14 +29,6 @@ namespace vazel
             (void)cm;
         }
 
-        void System::__addEntity(const Entity &entity,
-                                 const ComponentSignature &signature)
-        {
-            if (isValidSignature(signature, _signature)) {
-                _entities.emplace(entity);
-            }
-        }
-
         System::System(const std::string &tag)
             : _tag(tag)
             , _on_update(unimplementedOnUpdateSystem)
@@ -48,15 +41,46 @@ namespace vazel
         {
         }
 
+        System::System(const System &other,
+                       std::pmr::memory_resource *resource)
+            : _signature(other._signature)
+            , _tag(other._tag)
+            , _on_update(other._on_update)
+            , _entities(other._entities, resource)
+        {
+        }
+
         void System::updateValidEntities(EntityManager &emanager)
         {
-            for (const auto &t : emanager.getMap()) {
-                auto it = _entities.find(t.first);
-                if (it == _entities.end()) {
-                    __addEntity(t.first, t.second);
-                } else if (isValidSignature(t.second, _signature) == false) {
-                    _entities.erase(it);
+            const EntityMap &map = emanager.getMap();
+
+            for (auto it = _entities.begin(); it != _entities.end();) {
+                const auto found = map.find(*it);
+
+                if (found == map.end() ||
+                    isValidSignature(found->second.signature,
+                                     _signature) == false) {
+                    it = _entities.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            emanager.join(_signature, [this](const Entity &e) {
+                if (_entities.find(e) == _entities.end()) {
+                    _entities.emplace(e);
+                }
+            });
+        }
+
+        void System::updateEntity(const Entity &entity,
+                                  const ComponentSignature &signature)
+        {
+            if (isValidSignature(signature, _signature)) {
+                if (_entities.find(entity) == _entities.end()) {
+                    _entities.emplace(entity);
                 }
+            } else {
+                _entities.erase(entity);
             }
         }
 
@@ -75,8 +99,20 @@ namespace vazel
             return _tag;
         }
 
+        size_t System::getEntityCount(void) const
+        {
+            return _entities.size();
+        }
+
+        const std::pmr::unordered_set<Entity> &System::getEntities(void) const
+        {
+            return _entities;
+        }
+
         void System::onUpdate(ComponentManager &cm)
         {
+            VAZEL_TRACE_SCOPE(_tag.c_str(), "system");
+
             for (auto it : _entities) {
                 _on_update(cm, it);
             }
@@ -0,0 +1,83 @@
+/**
+ * src/ecs/System/SystemStats.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/System/SystemStats.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        void SystemStats::record(std::chrono::nanoseconds elapsed,
+                                 size_t entities)
+        {
+            const uint64_t calls = _calls.load(std::memory_order_relaxed);
+
+            _samples[calls % VAZEL_SYSTEM_STATS_SAMPLES].store(
+                elapsed.count(), std::memory_order_relaxed);
+            _entities.store(entities, std::memory_order_relaxed);
+            _entities_total.fetch_add(entities, std::memory_order_relaxed);
+            _calls.store(calls + 1, std::memory_order_release);
+        }
+
+        profiling::AllocCounter &SystemStats::allocations(void)
+        {
+            return _allocations;
+        }
+
+        SystemStatsSnapshot SystemStats::snapshot(const std::string &tag) const
+        {
+            SystemStatsSnapshot stats;
+            std::array<int64_t, VAZEL_SYSTEM_STATS_SAMPLES> samples;
+
+            stats.tag   = tag;
+            stats.calls = _calls.load(std::memory_order_acquire);
+            stats.entities =
+                static_cast<size_t>(_entities.load(std::memory_order_relaxed));
+            stats.entitiesTotal =
+                _entities_total.load(std::memory_order_relaxed);
+            stats.allocations = _allocations.get();
+            if (stats.calls == 0) {
+                return stats;
+            }
+
+            const size_t count = std::min<uint64_t>(
+                stats.calls, VAZEL_SYSTEM_STATS_SAMPLES);
+
+            for (size_t i = 0; i != count; i++) {
+                samples[i] = _samples[i].load(std::memory_order_relaxed);
+            }
+            stats.last = std::chrono::nanoseconds(
+                samples[(stats.calls - 1) % VAZEL_SYSTEM_STATS_SAMPLES]);
+            std::sort(samples.begin(), samples.begin() + count);
+            stats.min = std::chrono::nanoseconds(samples[0]);
+            stats.max = std::chrono::nanoseconds(samples[count - 1]);
+            stats.avg = std::chrono::nanoseconds(
+                std::accumulate(samples.begin(), samples.begin() + count,
+                                int64_t(0)) /
+                static_cast<int64_t>(count));
+            // Nearest rank
+            stats.p99 =
+                std::chrono::nanoseconds(samples[(count * 99 + 99) / 100 - 1]);
+            return stats;
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -16,6 +16,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Vazel/ecs/World/World.hpp"
+#include "Vazel/ecs/WorldReaper/WorldReaper.hpp"
+
+#include <utility>
 
 namespace vazel
 {
@@ -32,19 +35,49 @@ namespace vazel
             return _e.c_str();
         }
 
+        StructuralChanges StructuralChanges::operator-(
+            const StructuralChanges &other) const
+        {
+            return { entitiesCreated - other.entitiesCreated,
+                     entitiesRemoved - other.entitiesRemoved,
+                     componentsAttached - other.componentsAttached,
+                     componentsDetached - other.componentsDetached };
+        }
+
+        World::World(std::pmr::memory_resource *resource)
+            : _resource(resource)
+            , _entityManager(resource)
+            , _componentManager(_entityManager, resource)
+        {
+        }
+
+        World::World(WorldArena &arena)
+            : World(static_cast<std::pmr::memory_resource *>(&arena))
+        {
+            _arena = &arena;
+        }
+
         Entity World::createEntity(void)
         {
+            VAZEL_ALLOC_SCOPE("World::createEntity");
+
             Entity e = _entityManager.createEntity();
-            _componentManager.onEntityCreate(e);
+            _changes.entitiesCreated++;
             return e;
         }
 
         void World::removeEntity(Entity &e)
         {
+            VAZEL_ALLOC_SCOPE("World::removeEntity");
+
+            if (_spatialIndex != nullptr && _spatialIndex->contains(e)) {
+                _spatialIndex->remove(e);
+            }
             _entityManager.setSignature(e, ComponentSignature());
-            updateSystemsEntities();
-            _entityManager.destroyEntity(e);
+            __updateSystemsEntity(e);
             _componentManager.onEntityDestroy(e);
+            _entityManager.destroyEntity(e);
+            _changes.entitiesRemoved++;
         }
 
         void World::removeSystem(const char *tag)
@@ -52,6 +85,10 @@ namespace vazel
             const auto it = __getSystemIteratorFromTag(tag);
 
             if (it != _systems.end()) {
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+                _systemStats.erase(_systemStats.begin() +
+                                   (it - _systems.begin()));
+#endif
                 _systems.erase(it);
                 return;
             }
@@ -69,6 +106,8 @@ namespace vazel
 
         void World::registerSystem(System &sys)
         {
+            VAZEL_ALLOC_SCOPE("World::registerSystem");
+
             if (sys.getSignature() == 0) {
                 throw WorldException(
                     "World::addSystem: System signature is 0");
@@ -83,12 +122,15 @@ namespace vazel
                 throw WorldException(err);
             }
             sys.updateValidEntities(_entityManager);
-            _systems.push_back(std::make_unique<System>(sys));
+            _systems.push_back(std::make_unique<System>(sys, _resource));
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+            _systemStats.push_back(std::make_unique<SystemStats>());
+#endif
         }
 
         const ComponentSignature &World::getEntitySignature(Entity &e)
         {
-            return _entityManager.getSignature(e);
+            return std::as_const(_entityManager).getSignature(e);
         }
 
         const ComponentSignature &World::getComponentManagerSignature(
@@ -97,6 +139,16 @@ namespace vazel
             return _componentManager.getComponentSignature();
         }
 
+        void World::__updateSystemsEntity(const Entity &e)
+        {
+            const ComponentSignature &signature =
+                std::as_const(_entityManager).getSignature(e);
+
+            for (auto &it : _systems) {
+                it->updateEntity(e, signature);
+            }
+        }
+
         void World::updateSystemsEntities(void)
         {
             for (auto &it : _systems) {
@@ -104,18 +156,238 @@ namespace vazel
             }
         }
 
+        void World::disableSpatialIndex(void)
+        {
+            _spatialIndex.reset();
+            _spatialPosition = nullptr;
+        }
+
+        bool World::hasSpatialIndex(void) const
+        {
+            return _spatialIndex != nullptr;
+        }
+
+        const SpatialGrid &World::getSpatialIndex(void) const
+        {
+            if (_spatialIndex == nullptr) {
+                throw WorldException(
+                    "World::getSpatialIndex: The spatial index is not "
+                    "enabled");
+            }
+            return *_spatialIndex;
+        }
+
+        void World::updateSpatialIndex(void)
+        {
+            if (_spatialIndex == nullptr) {
+                return;
+            }
+            _spatialIndex->refresh([this](const Entity &e) {
+                return _spatialPosition(_componentManager, e);
+            });
+        }
+
         void World::updateSystem(void)
         {
-            for (auto &it : _systems) {
-                it->onUpdate(_componentManager);
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+            _frameAllocations.reset();
+            profiling::AllocScope frameScope(_frameAllocations);
+#endif
+            updateSpatialIndex();
+            for (size_t i = 0; i != _systems.size(); i++) {
+                System &system = *_systems[i];
+
+                if (_probe != nullptr) {
+                    _probe->onSystemBegin(system);
+                }
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+                const auto begin = std::chrono::steady_clock::now();
+                {
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+                    profiling::AllocScope scope(
+                        _systemStats[i]->allocations());
+#endif
+                    system.onUpdate(_componentManager);
+                }
+                const std::chrono::nanoseconds elapsed =
+                    std::chrono::steady_clock::now() - begin;
+
+                _systemStats[i]->record(elapsed, system.getEntityCount());
+                if (_metrics != nullptr) {
+                    _metrics->recordSystem(i, system, elapsed);
+                }
+#else
+                if (_metrics != nullptr) {
+                    const auto begin = std::chrono::steady_clock::now();
+
+                    system.onUpdate(_componentManager);
+                    _metrics->recordSystem(
+                        i, system, std::chrono::steady_clock::now() - begin);
+                } else {
+                    system.onUpdate(_componentManager);
+                }
+#endif
+                if (_probe != nullptr) {
+                    _probe->onSystemEnd(system);
+                }
             }
+            for (auto &it : _events) {
+                it.second->flip();
+            }
+            _scratch.reset();
+            if (_metrics != nullptr) {
+                _metrics->publish(_componentManager, getEntityCount(),
+                                  _events);
+            }
+        }
+
+        profiling::AllocStats World::getFrameAllocations(void) const
+        {
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+            return _frameAllocations.get();
+#else
+            return profiling::AllocStats();
+#endif
+        }
+
+        MemoryReport World::memoryReport(void) const
+        {
+            MemoryReport report;
+
+            report.components =
+                measureComponents(_componentManager, _resource);
+            report.entities =
+                measureContainer("entities", _entityManager.getMap());
+            report.entityIndex.name     = "entity index";
+            report.entityIndex.elements = _entityManager.getIndexCount();
+            report.entityIndex.usedBytes =
+                _entityManager.getIndexCount() * sizeof(Entity);
+            report.entityIndex.reservedBytes = _entityManager.getIndexBytes();
+            for (const auto &it : _systems) {
+                report.systems.push_back(measureContainer(
+                    "system " + it->getTag(), it->getEntities()));
+            }
+            if (_arena != nullptr) {
+                report.arenaAllocated = _arena->getAllocated();
+                report.arenaReserved  = _arena->getReserved();
+            }
+            return report;
+        }
+
+        ScratchArena &World::scratch(void)
+        {
+            return _scratch;
+        }
+
+        std::vector<SystemStatsSnapshot> World::systemStats(void) const
+        {
+            std::vector<SystemStatsSnapshot> stats;
+
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+            stats.reserve(_systems.size());
+            for (size_t i = 0; i != _systems.size(); i++) {
+                stats.push_back(
+                    _systemStats[i]->snapshot(_systems[i]->getTag()));
+            }
+#endif
+            return stats;
+        }
+
+        void World::setSystemProbe(SystemProbe *probe)
+        {
+            _probe = probe;
+        }
+
+        SystemProbe *World::getSystemProbe(void) const
+        {
+            return _probe;
+        }
+
+        void World::setMetrics(WorldMetrics *metrics)
+        {
+            _metrics = metrics;
+        }
+
+        size_t World::getEntityCount(void) const
+        {
+            return _entityManager.getMap().size();
+        }
+
+        const StructuralChanges &World::getStructuralChanges(void) const
+        {
+            return _changes;
+        }
+
+        void World::setDeltaTime(double deltaTime)
+        {
+            _deltaTime = deltaTime;
+        }
+
+        double World::getDeltaTime(void) const
+        {
+            return _deltaTime;
         }
 
         void World::clearWorld(void)
         {
+            disableSpatialIndex();
+            _events.clear();
             _systems.clear();
-            _componentManager.clear();
-            _entityManager.clear();
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+            _systemStats.clear();
+#endif
+            {
+                // Swapped with empty managers so their buckets are freed too
+                EntityManager entities(_resource);
+                ComponentManager components(entities, _resource);
+
+                _componentManager.swap(components);
+                _entityManager.swap(entities);
+            }
+            if (_arena != nullptr) {
+                _arena->release();
+            }
+        }
+
+        std::pmr::memory_resource *World::getMemoryResource(void) const
+        {
+            return _resource;
+        }
+
+        void World::clearWorldAsync(void)
+        {
+            clearWorldAsync(WorldReaper::getInstance());
+        }
+
+        void World::clearWorldAsync(WorldReaper &reaper)
+        {
+            if (_arena != nullptr) {
+                clearWorld();
+                return;
+            }
+            auto old = std::make_unique<World>(_resource);
+
+            old->swap(*this);
+            reaper.reap(std::move(old));
+        }
+
+        void World::swap(World &other)
+        {
+            if (_resource != other._resource) {
+                throw WorldException("World::swap: The worlds do not use the "
+                                     "same memory resource");
+            }
+            std::swap(_systems, other._systems);
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+            std::swap(_systemStats, other._systemStats);
+#endif
+            _componentManager.swap(other._componentManager);
+            _entityManager.swap(other._entityManager);
+            std::swap(_events, other._events);
+            std::swap(_spatialIndex, other._spatialIndex);
+            std::swap(_spatialComponent, other._spatialComponent);
+            std::swap(_spatialPosition, other._spatialPosition);
+            std::swap(_deltaTime, other._deltaTime);
         }
 
     } // namespace ecs
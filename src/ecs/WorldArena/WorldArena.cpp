@@ -0,0 +1,118 @@
+/**
+ * src/ecs/WorldArena/WorldArena.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/WorldArena/WorldArena.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        WorldArena::Upstream::Upstream(std::pmr::memory_resource *resource)
+            : parent(resource)
+        {
+        }
+
+        void *WorldArena::Upstream::do_allocate(size_t bytes, size_t align)
+        {
+            if (limit != 0 && reserved + bytes > limit) {
+                throw std::bad_alloc();
+            }
+            void *ptr = parent->allocate(bytes, align);
+
+            reserved += bytes;
+            peak = std::max(peak, reserved);
+            return ptr;
+        }
+
+        void WorldArena::Upstream::do_deallocate(void *ptr, size_t bytes,
+                                                 size_t align)
+        {
+            parent->deallocate(ptr, bytes, align);
+            reserved -= bytes;
+        }
+
+        bool WorldArena::Upstream::do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept
+        {
+            return this == &other;
+        }
+
+        WorldArena::WorldArena(size_t limit,
+                               std::pmr::memory_resource *upstream)
+            : _upstream(upstream)
+            , _pool(&_upstream)
+        {
+            _upstream.limit = limit;
+        }
+
+        void WorldArena::release(void)
+        {
+            _pool.release();
+            _allocated = 0;
+        }
+
+        size_t WorldArena::getAllocated(void) const
+        {
+            return _allocated;
+        }
+
+        size_t WorldArena::getReserved(void) const
+        {
+            return _upstream.reserved;
+        }
+
+        size_t WorldArena::getPeak(void) const
+        {
+            return _upstream.peak;
+        }
+
+        size_t WorldArena::getLimit(void) const
+        {
+            return _upstream.limit;
+        }
+
+        void WorldArena::setLimit(size_t limit)
+        {
+            _upstream.limit = limit;
+        }
+
+        void *WorldArena::do_allocate(size_t bytes, size_t align)
+        {
+            void *ptr = _pool.allocate(bytes, align);
+
+            _allocated += bytes;
+            return ptr;
+        }
+
+        void WorldArena::do_deallocate(void *ptr, size_t bytes, size_t align)
+        {
+            _pool.deallocate(ptr, bytes, align);
+            _allocated -= bytes;
+        }
+
+        bool WorldArena::do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept
+        {
+            return this == &other;
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,96 @@
+/**
+ * src/ecs/WorldMetrics/WorldMetrics.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/WorldMetrics/WorldMetrics.hpp"
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        WorldMetrics::WorldMetrics(const std::string &world,
+                                   profiling::Metrics &metrics)
+            : _metrics(metrics)
+            , _labels(profiling::metricLabel("world", world))
+            , _entities(metrics.gauge("vazel_entities",
+                                      "Entities alive in the world", _labels))
+        {
+        }
+
+        void WorldMetrics::recordSystem(size_t index, const System &system,
+                                        std::chrono::nanoseconds elapsed)
+        {
+            if (index >= _systems.size()) {
+                _systems.resize(index + 1);
+            }
+            SystemMetrics &metrics = _systems[index];
+
+            if (metrics.system != &system) {
+                const std::string labels =
+                    _labels + "," +
+                    profiling::metricLabel("system", system.getTag());
+
+                metrics.system = &system;
+                metrics.time   = &_metrics.counter(
+                    "vazel_system_seconds_total",
+                    "Time spent in the updates of the system", labels, 1e-9);
+                metrics.updates = &_metrics.counter(
+                    "vazel_system_updates_total", "Updates of the system",
+                    labels);
+                metrics.entities = &_metrics.gauge(
+                    "vazel_system_entities",
+                    "Entities updated by the system", labels);
+            }
+            metrics.time->add(elapsed.count());
+            metrics.updates->add();
+            metrics.entities->set(system.getEntityCount());
+        }
+
+        void WorldMetrics::publish(const ComponentManager &components,
+                                   size_t entities,
+                                   const EventChannelMap &events)
+        {
+            _entities.set(entities);
+            for (const auto &it : components.getComponentMap()) {
+                ComponentMetrics &metrics = _components[it.second];
+
+                if (metrics.name != it.first) {
+                    metrics.name  = it.first;
+                    metrics.count = &_metrics.gauge(
+                        "vazel_components",
+                        "Components of a type attached in the world",
+                        _labels + "," +
+                            profiling::metricLabel("component", it.first));
+                }
+                metrics.count->set(components.getComponentCount(it.second));
+            }
+            for (const auto &it : events) {
+                profiling::Gauge *&gauge = _channels[it.first];
+
+                if (gauge == nullptr) {
+                    gauge = &_metrics.gauge(
+                        "vazel_events_pending",
+                        "Events waiting in an event channel of the world",
+                        _labels + "," +
+                            profiling::metricLabel("event", it.first));
+                }
+                gauge->set(it.second->pending());
+            }
+        }
+
+    } // namespace ecs
+} // namespace vazel
@@ -0,0 +1,102 @@
+/**
+ * src/ecs/WorldReaper/WorldReaper.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/WorldReaper/WorldReaper.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace vazel
+{
+    namespace ecs
+    {
+
+        WorldReaper::WorldReaper(void)
+            : _thread(&WorldReaper::__reaperLoop, this)
+        {
+        }
+
+        WorldReaper::~WorldReaper(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _stopping = true;
+            }
+            _cv_work.notify_all();
+            _thread.join();
+        }
+
+        WorldReaper &WorldReaper::getInstance(void)
+        {
+            static WorldReaper reaper;
+
+            return reaper;
+        }
+
+        void WorldReaper::reap(std::unique_ptr<World> world)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _queue.push_back(std::move(world));
+                _pending++;
+            }
+            _cv_work.notify_one();
+        }
+
+        void WorldReaper::wait(void)
+        {
+            std::unique_lock<std::mutex> lock(_mut);
+
+            _cv_done.wait(lock, [this] { return _pending == 0; });
+        }
+
+        size_t WorldReaper::pending(void)
+        {
+            std::lock_guard<std::mutex> lock(_mut);
+
+            return _pending;
+        }
+
+        void WorldReaper::__reaperLoop(void)
+        {
+#if defined(__linux__)
+            // The nice value is per thread on Linux
+            setpriority(PRIO_PROCESS, 0, 19);
+#endif
+            std::unique_lock<std::mutex> lock(_mut);
+            std::vector<std::unique_ptr<World>> batch;
+
+            while (true) {
+                _cv_work.wait(lock,
+                              [this] { return _stopping || !_queue.empty(); });
+                if (_queue.empty()) {
+                    return;
+                }
+                batch.swap(_queue);
+                lock.unlock();
+                const size_t count = batch.size();
+                batch.clear();
+                lock.lock();
+                _pending -= count;
+                _cv_done.notify_all();
+            }
+        }
+
+    } // namespace ecs
+} // namespace vazel
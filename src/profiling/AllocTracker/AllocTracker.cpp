@@ -0,0 +1,259 @@
+/**
+ * src/profiling/AllocTracker/AllocTracker.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/profiling/AllocTracker/AllocTracker.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <new>
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        // Plain pointer: a thread_local with a destructor could allocate
+        static thread_local AllocScope *t_scope = nullptr;
+        static std::atomic<AllocSite *> s_sites = nullptr;
+        static AllocCounter s_total;
+
+        AllocStats &AllocStats::operator+=(const AllocStats &other)
+        {
+            allocations += other.allocations;
+            bytes += other.bytes;
+            return *this;
+        }
+
+        void AllocCounter::add(size_t bytes)
+        {
+            _allocations.fetch_add(1, std::memory_order_relaxed);
+            _bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        AllocStats AllocCounter::get(void) const
+        {
+            AllocStats stats;
+
+            stats.allocations = _allocations.load(std::memory_order_relaxed);
+            stats.bytes       = _bytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void AllocCounter::reset(void)
+        {
+            _allocations.store(0, std::memory_order_relaxed);
+            _bytes.store(0, std::memory_order_relaxed);
+        }
+
+        AllocSite::AllocSite(const char *siteName)
+            : name(siteName)
+            , next(s_sites.load())
+        {
+            while (!s_sites.compare_exchange_weak(next, this)) {
+            }
+        }
+
+        AllocScope::AllocScope(AllocCounter &counter)
+            : _counter(counter)
+            , _parent(t_scope)
+        {
+            t_scope = this;
+        }
+
+        AllocScope::~AllocScope(void)
+        {
+            t_scope = _parent;
+        }
+
+        void AllocScope::record(size_t bytes)
+        {
+            s_total.add(bytes);
+            for (AllocScope *scope = t_scope; scope; scope = scope->_parent) {
+                scope->_counter.add(bytes);
+            }
+        }
+
+        bool allocTrackingEnabled(void)
+        {
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        AllocStats allocTotal(void)
+        {
+            return s_total.get();
+        }
+
+        std::vector<std::pair<std::string, AllocStats>> allocSites(void)
+        {
+            std::map<std::string, AllocStats> merged;
+
+            for (AllocSite *site = s_sites.load(); site; site = site->next) {
+                merged[site->name] += site->counter.get();
+            }
+            return { merged.begin(), merged.end() };
+        }
+
+        void resetAllocSites(void)
+        {
+            for (AllocSite *site = s_sites.load(); site; site = site->next) {
+                site->counter.reset();
+            }
+        }
+
+    } // namespace profiling
+} // namespace vazel
+
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+
+// Replaced global allocation functions, they forward to malloc and free
+// (aligned_alloc for over-aligned types)
+
+static void *trackedAlloc(size_t size)
+{
+    vazel::profiling::AllocScope::record(size);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+static void *trackedAlignedAlloc(size_t size, std::align_val_t align)
+{
+    const size_t alignment = static_cast<size_t>(align);
+    // aligned_alloc wants a multiple of the alignment
+    const size_t rounded = (size + alignment - 1) / alignment * alignment;
+
+    vazel::profiling::AllocScope::record(size);
+    return std::aligned_alloc(alignment, rounded != 0 ? rounded : alignment);
+}
+
+void *operator new(size_t size)
+{
+    void *ptr = trackedAlloc(size);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    void *ptr = trackedAlignedAlloc(size, align);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+void *operator new(size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept
+{
+    return trackedAlignedAlloc(size, align);
+}
+
+void *operator new[](size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept
+{
+    return trackedAlignedAlloc(size, align);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t,
+                     const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t,
+                       const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
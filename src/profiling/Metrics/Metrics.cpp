@@ -0,0 +1,398 @@
+/**
+ * src/profiling/Metrics/Metrics.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/profiling/Metrics/Metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        MetricsException::MetricsException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *MetricsException::what() const throw()
+        {
+            return _e.c_str();
+        }
+
+        static const char *kindName(MetricKind kind)
+        {
+            switch (kind) {
+            case MetricKind::Counter:
+                return "counter";
+            case MetricKind::Gauge:
+                return "gauge";
+            case MetricKind::Histogram:
+                return "histogram";
+            }
+            return "untyped";
+        }
+
+        static void writeHelp(std::ostream &out, const std::string &help)
+        {
+            for (const char c : help) {
+                if (c == '\\') {
+                    out << "\\\\";
+                } else if (c == '\n') {
+                    out << "\\n";
+                } else {
+                    out << c;
+                }
+            }
+        }
+
+        static bool isValidName(const std::string &name)
+        {
+            if (name.empty() || isdigit(name[0])) {
+                return false;
+            }
+            return std::all_of(name.begin(), name.end(), [](char c) {
+                return isalnum(c) || c == '_' || c == ':';
+            });
+        }
+
+        Metric::Metric(const std::string &name, const std::string &help,
+                       const std::string &labels)
+            : _name(name)
+            , _help(help)
+            , _labels(labels)
+        {
+        }
+
+        const std::string &Metric::getName(void) const
+        {
+            return _name;
+        }
+
+        const std::string &Metric::getHelp(void) const
+        {
+            return _help;
+        }
+
+        const std::string &Metric::getLabels(void) const
+        {
+            return _labels;
+        }
+
+        void Metric::writeSample(std::ostream &out, const char *suffix,
+                                 const std::string &extra, double value) const
+        {
+            char buf[64] = { 0 };
+
+            out << _name << suffix;
+            if (_labels.empty() == false || extra.empty() == false) {
+                out << '{' << _labels;
+                if (_labels.empty() == false && extra.empty() == false) {
+                    out << ',';
+                }
+                out << extra << '}';
+            }
+            snprintf(buf, sizeof(buf) - 1, "%.15g", value);
+            out << ' ' << buf << '\n';
+        }
+
+        Counter::Counter(const std::string &name, const std::string &help,
+                         const std::string &labels, double scale)
+            : Metric(name, help, labels)
+            , _scale(scale)
+        {
+        }
+
+        int64_t Counter::getValue(void) const
+        {
+            int64_t value = 0;
+
+            for (const auto &cell : _cells) {
+                value += cell.value.load(std::memory_order_relaxed);
+            }
+            return value;
+        }
+
+        MetricKind Counter::getKind(void) const
+        {
+            return MetricKind::Counter;
+        }
+
+        void Counter::write(std::ostream &out) const
+        {
+            writeSample(out, "", "", getValue() * _scale);
+        }
+
+        Gauge::Gauge(const std::string &name, const std::string &help,
+                     const std::string &labels)
+            : Metric(name, help, labels)
+        {
+        }
+
+        double Gauge::getValue(void) const
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        MetricKind Gauge::getKind(void) const
+        {
+            return MetricKind::Gauge;
+        }
+
+        void Gauge::write(std::ostream &out) const
+        {
+            writeSample(out, "", "", getValue());
+        }
+
+        Histogram::Histogram(const std::string &name, const std::string &help,
+                             const std::string &labels)
+            : Metric(name, help, labels)
+        {
+        }
+
+        std::chrono::nanoseconds Histogram::getBound(size_t bucket)
+        {
+            return std::chrono::nanoseconds(int64_t(1) << (bucket + 14));
+        }
+
+        void Histogram::observe(std::chrono::nanoseconds duration)
+        {
+            const uint64_t ns = std::max<int64_t>(duration.count(), 0);
+            // Bucket i holds the durations up to 2^(i + 14) ns
+            const size_t width  = std::bit_width(ns > 0 ? ns - 1 : ns);
+            const size_t bucket = std::min<size_t>(
+                std::max<size_t>(width, 14) - 14,
+                VAZEL_METRICS_HISTOGRAM_BUCKETS);
+            Lane &lane                   = _lanes[threadSlot()];
+            std::atomic<uint64_t> &count = lane.buckets[bucket];
+
+            // Only the owner of the slot writes its lane
+            count.store(count.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+            lane.sum.store(lane.sum.load(std::memory_order_relaxed) + ns,
+                           std::memory_order_relaxed);
+        }
+
+        Histogram::Buckets Histogram::__getBuckets(void) const
+        {
+            Buckets counts = {};
+
+            for (const auto &lane : _lanes) {
+                for (size_t i = 0; i != counts.size(); i++) {
+                    counts[i] +=
+                        lane.buckets[i].load(std::memory_order_relaxed);
+                }
+            }
+            return counts;
+        }
+
+        uint64_t Histogram::getCount(void) const
+        {
+            const Buckets counts = __getBuckets();
+
+            return std::accumulate(counts.begin(), counts.end(),
+                                   uint64_t(0));
+        }
+
+        std::chrono::nanoseconds Histogram::getQuantile(double quantile) const
+        {
+            const Buckets counts = __getBuckets();
+            const uint64_t total =
+                std::accumulate(counts.begin(), counts.end(), uint64_t(0));
+
+            if (total == 0) {
+                return std::chrono::nanoseconds::zero();
+            }
+            const uint64_t rank = std::max<uint64_t>(
+                static_cast<uint64_t>(
+                    std::ceil(std::clamp(quantile, 0.0, 1.0) * total)),
+                1);
+            uint64_t seen = 0;
+
+            for (size_t i = 0; i != VAZEL_METRICS_HISTOGRAM_BUCKETS; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    return getBound(i);
+                }
+            }
+            return getBound(VAZEL_METRICS_HISTOGRAM_BUCKETS - 1);
+        }
+
+        MetricKind Histogram::getKind(void) const
+        {
+            return MetricKind::Histogram;
+        }
+
+        void Histogram::write(std::ostream &out) const
+        {
+            const Buckets counts = __getBuckets();
+            uint64_t sum         = 0;
+            uint64_t total       = 0;
+
+            for (const auto &lane : _lanes) {
+                sum += lane.sum.load(std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i != counts.size(); i++) {
+                char le[64] = { 0 };
+
+                total += counts[i];
+                if (i == VAZEL_METRICS_HISTOGRAM_BUCKETS) {
+                    snprintf(le, sizeof(le) - 1, "le=\"+Inf\"");
+                } else {
+                    snprintf(le, sizeof(le) - 1, "le=\"%.9g\"",
+                             getBound(i).count() * 1e-9);
+                }
+                writeSample(out, "_bucket", le, total);
+            }
+            writeSample(out, "_sum", "", sum * 1e-9);
+            writeSample(out, "_count", "", total);
+        }
+
+        Metrics &Metrics::getInstance(void)
+        {
+            static Metrics metrics;
+
+            return metrics;
+        }
+
+        Metric *Metrics::__find(const std::string &name,
+                                const std::string &labels,
+                                MetricKind kind) const
+        {
+            if (isValidName(name) == false) {
+                throw MetricsException("Metrics: Invalid metric name \"" +
+                                       name + "\"");
+            }
+            for (const auto &it : _metrics) {
+                if (it->getName() != name) {
+                    continue;
+                }
+                if (it->getKind() != kind) {
+                    throw MetricsException(
+                        "Metrics: \"" + name + "\" is already declared as a " +
+                        kindName(it->getKind()));
+                }
+                if (it->getLabels() == labels) {
+                    return it.get();
+                }
+            }
+            return nullptr;
+        }
+
+        Counter &Metrics::counter(const std::string &name,
+                                  const std::string &help,
+                                  const std::string &labels, double scale)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Metric *metric = __find(name, labels, MetricKind::Counter);
+
+            if (metric == nullptr) {
+                _metrics.push_back(
+                    std::make_unique<Counter>(name, help, labels, scale));
+                metric = _metrics.back().get();
+            }
+            return static_cast<Counter &>(*metric);
+        }
+
+        Gauge &Metrics::gauge(const std::string &name, const std::string &help,
+                              const std::string &labels)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Metric *metric = __find(name, labels, MetricKind::Gauge);
+
+            if (metric == nullptr) {
+                _metrics.push_back(
+                    std::make_unique<Gauge>(name, help, labels));
+                metric = _metrics.back().get();
+            }
+            return static_cast<Gauge &>(*metric);
+        }
+
+        Histogram &Metrics::histogram(const std::string &name,
+                                      const std::string &help,
+                                      const std::string &labels)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Metric *metric = __find(name, labels, MetricKind::Histogram);
+
+            if (metric == nullptr) {
+                _metrics.push_back(
+                    std::make_unique<Histogram>(name, help, labels));
+                metric = _metrics.back().get();
+            }
+            return static_cast<Histogram &>(*metric);
+        }
+
+        size_t Metrics::size(void) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            return _metrics.size();
+        }
+
+        void Metrics::writePrometheus(std::ostream &out) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // The samples of a metric follow its HELP and TYPE lines
+            for (size_t i = 0; i != _metrics.size(); i++) {
+                const Metric &first = *_metrics[i];
+                const auto same     = [&first](const auto &it) {
+                    return it->getName() == first.getName();
+                };
+
+                if (std::any_of(_metrics.begin(), _metrics.begin() + i,
+                                same)) {
+                    continue;
+                }
+                out << "# HELP " << first.getName() << ' ';
+                writeHelp(out, first.getHelp());
+                out << "\n# TYPE " << first.getName() << ' '
+                    << kindName(first.getKind()) << '\n';
+                for (size_t j = i; j != _metrics.size(); j++) {
+                    if (same(_metrics[j])) {
+                        _metrics[j]->write(out);
+                    }
+                }
+            }
+        }
+
+        std::string metricLabel(const std::string &key,
+                                const std::string &value)
+        {
+            std::string label = key + "=\"";
+
+            for (const char c : value) {
+                if (c == '\\' || c == '"') {
+                    label += '\\';
+                    label += c;
+                } else if (c == '\n') {
+                    label += "\\n";
+                } else {
+                    label += c;
+                }
+            }
+            return label + '"';
+        }
+
+    } // namespace profiling
+} // namespace vazel
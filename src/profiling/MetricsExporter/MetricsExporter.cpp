@@ -0,0 +1,249 @@
+/**
+ * src/profiling/MetricsExporter/MetricsExporter.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/profiling/MetricsExporter/MetricsExporter.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        MetricsExporter::MetricsExporter(Metrics &metrics)
+            : _metrics(metrics)
+        {
+        }
+
+        MetricsExporter::~MetricsExporter(void)
+        {
+            stop();
+        }
+
+        void MetricsExporter::writeFile(const std::string &path)
+        {
+            const std::string tmp = path + ".tmp";
+            {
+                std::ofstream file(tmp, std::ios::trunc);
+
+                _metrics.writePrometheus(file);
+                file.flush();
+                if (!file) {
+                    std::remove(tmp.c_str());
+                    throw MetricsException(
+                        "MetricsExporter::writeFile: Cannot write " + tmp);
+                }
+            }
+            if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+                std::remove(tmp.c_str());
+                throw MetricsException(
+                    "MetricsExporter::writeFile: Cannot rename " + tmp +
+                    " to " + path);
+            }
+            _exports.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void MetricsExporter::startFile(const std::string &path,
+                                        std::chrono::milliseconds period)
+        {
+            if (isRunning()) {
+                throw MetricsException(
+                    "MetricsExporter::startFile: The exporter is running");
+            }
+            writeFile(path);
+            _running = true;
+            _thread  = std::thread(&MetricsExporter::__fileLoop, this, path,
+                                  period);
+        }
+
+        void MetricsExporter::__fileLoop(std::string path,
+                                         std::chrono::milliseconds period)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (_wake.wait_for(lock, period, [this]() {
+                return _running == false;
+            }) == false) {
+                lock.unlock();
+                try {
+                    writeFile(path);
+                } catch (const MetricsException &) {
+                    // Retried at the next period
+                }
+                lock.lock();
+            }
+        }
+
+        void MetricsExporter::startSocket(const std::string &path)
+        {
+            if (isRunning()) {
+                throw MetricsException(
+                    "MetricsExporter::startSocket: The exporter is running");
+            }
+#if defined(__unix__) || defined(__APPLE__)
+            struct sockaddr_un addr;
+
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(addr.sun_path)) {
+                throw MetricsException(
+                    "MetricsExporter::startSocket: The path is too long: " +
+                    path);
+            }
+            strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+            _socket = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (_socket < 0) {
+                throw MetricsException(
+                    "MetricsExporter::startSocket: Cannot create a socket: " +
+                    std::string(strerror(errno)));
+            }
+            unlink(path.c_str());
+            if (bind(_socket, reinterpret_cast<struct sockaddr *>(&addr),
+                     sizeof(addr)) != 0 ||
+                listen(_socket, 16) != 0) {
+                const std::string err = strerror(errno);
+
+                close(_socket);
+                _socket = -1;
+                throw MetricsException(
+                    "MetricsExporter::startSocket: Cannot listen on " + path +
+                    ": " + err);
+            }
+            _socket_path = path;
+            _running     = true;
+            _thread      = std::thread(&MetricsExporter::__socketLoop, this);
+#else
+            throw MetricsException("MetricsExporter::startSocket: UNIX "
+                                   "sockets are not available");
+#endif
+        }
+
+        void MetricsExporter::__socketLoop(void)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            while (_running) {
+                // Wakes up regularly to notice stop
+                struct pollfd listener = { _socket, POLLIN, 0 };
+
+                if (poll(&listener, 1, 100) <= 0) {
+                    continue;
+                }
+                const int client = accept(_socket, nullptr, nullptr);
+
+                if (client < 0) {
+                    continue;
+                }
+                struct timeval timeout = { 1, 0 };
+                char request[4096]     = { 0 };
+                size_t size            = 0;
+
+                setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                           sizeof(timeout));
+                while (size < sizeof(request) - 1 &&
+                       strstr(request, "\r\n\r\n") == nullptr) {
+                    const ssize_t n = recv(client, request + size,
+                                           sizeof(request) - 1 - size, 0);
+
+                    if (n <= 0) {
+                        break;
+                    }
+                    size += n;
+                }
+                std::ostringstream body;
+                const bool get = strncmp(request, "GET ", 4) == 0;
+
+                if (get) {
+                    _metrics.writePrometheus(body);
+                }
+                char header[BUFSIZ] = { 0 };
+                const std::string content = body.str();
+                const int length          = snprintf(
+                    header, sizeof(header) - 1,
+                    "HTTP/1.0 %s\r\n"
+                    "Content-Type: text/plain; version=0.0.4\r\n"
+                    "Content-Length: %zu\r\n"
+                    "Connection: close\r\n\r\n",
+                    get ? "200 OK" : "405 Method Not Allowed",
+                    content.size());
+                const std::string response =
+                    std::string(header, length) + content;
+
+                for (size_t sent = 0; sent < response.size();) {
+                    const ssize_t n =
+                        send(client, response.data() + sent,
+                             response.size() - sent, MSG_NOSIGNAL);
+
+                    if (n <= 0) {
+                        break;
+                    }
+                    sent += n;
+                }
+                close(client);
+                if (get) {
+                    _exports.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+#endif
+        }
+
+        void MetricsExporter::stop(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _running = false;
+            }
+            _wake.notify_all();
+            if (_thread.joinable()) {
+                _thread.join();
+            }
+#if defined(__unix__) || defined(__APPLE__)
+            if (_socket >= 0) {
+                close(_socket);
+                unlink(_socket_path.c_str());
+                _socket = -1;
+            }
+#endif
+        }
+
+        bool MetricsExporter::isRunning(void) const
+        {
+            return _running;
+        }
+
+        uint64_t MetricsExporter::getExportCount(void) const
+        {
+            return _exports.load(std::memory_order_relaxed);
+        }
+
+    } // namespace profiling
+} // namespace vazel
@@ -0,0 +1,217 @@
+/**
+ * src/profiling/Trace/Trace.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/profiling/Trace/Trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace vazel
+{
+    namespace profiling
+    {
+
+        TraceException::TraceException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *TraceException::what() const throw()
+        {
+            return _e.c_str();
+        }
+
+        Tracer::Tracer(void)
+            : _epoch(std::chrono::steady_clock::now())
+        {
+        }
+
+        Tracer::~Tracer(void)
+        {
+            for (auto &lane : _lanes) {
+                delete[] lane.events.load();
+            }
+        }
+
+        Tracer &Tracer::getInstance(void)
+        {
+            static Tracer tracer;
+
+            return tracer;
+        }
+
+        void Tracer::start(void)
+        {
+            _recording.store(true, std::memory_order_relaxed);
+        }
+
+        void Tracer::stop(void)
+        {
+            _recording.store(false, std::memory_order_relaxed);
+        }
+
+        bool Tracer::isRecording(void) const
+        {
+            return _recording.load(std::memory_order_relaxed);
+        }
+
+        void Tracer::record(const char *name, const char *category,
+                            std::chrono::steady_clock::time_point begin,
+                            std::chrono::steady_clock::time_point end,
+                            uint64_t id)
+        {
+            Lane &lane          = _lanes[threadSlot()];
+            TraceEvent *events  = lane.events.load(std::memory_order_acquire);
+            const uint64_t head = lane.head.load(std::memory_order_relaxed);
+
+            if (events == nullptr) {
+                // Only the owner of the slot allocates its lane
+                events = new TraceEvent[VAZEL_TRACE_BUFFER_SIZE];
+                lane.events.store(events, std::memory_order_release);
+            }
+            TraceEvent &event = events[head % VAZEL_TRACE_BUFFER_SIZE];
+
+            strncpy(event.name, name, VAZEL_TRACE_NAME_SIZE - 1);
+            event.name[VAZEL_TRACE_NAME_SIZE - 1] = '\0';
+            event.category = category;
+            event.begin    = (begin - _epoch).count();
+            event.duration = (end - begin).count();
+            event.id       = id;
+            lane.head.store(head + 1, std::memory_order_release);
+        }
+
+        void Tracer::clear(void)
+        {
+            for (auto &lane : _lanes) {
+                lane.head.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        size_t Tracer::getEventCount(void) const
+        {
+            size_t count = 0;
+
+            for (const auto &lane : _lanes) {
+                if (lane.events.load(std::memory_order_acquire) != nullptr) {
+                    count += std::min<uint64_t>(
+                        lane.head.load(std::memory_order_acquire),
+                        VAZEL_TRACE_BUFFER_SIZE);
+                }
+            }
+            return count;
+        }
+
+        static void writeJsonString(std::ostream &out, const char *str)
+        {
+            out << '"';
+            for (; *str != '\0'; str++) {
+                if (*str == '"' || *str == '\\') {
+                    out << '\\' << *str;
+                } else if (static_cast<unsigned char>(*str) < 0x20) {
+                    char buf[8];
+
+                    snprintf(buf, sizeof(buf), "\\u%04x", *str);
+                    out << buf;
+                } else {
+                    out << *str;
+                }
+            }
+            out << '"';
+        }
+
+        void Tracer::writeChromeTrace(std::ostream &out) const
+        {
+            bool first = true;
+
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            for (size_t slot = 0; slot != _lanes.size(); slot++) {
+                const TraceEvent *events =
+                    _lanes[slot].events.load(std::memory_order_acquire);
+                const uint64_t head =
+                    _lanes[slot].head.load(std::memory_order_acquire);
+
+                if (events == nullptr) {
+                    continue;
+                }
+                const uint64_t from = head > VAZEL_TRACE_BUFFER_SIZE
+                                          ? head - VAZEL_TRACE_BUFFER_SIZE
+                                          : 0;
+
+                for (uint64_t i = from; i != head; i++) {
+                    const TraceEvent &event =
+                        events[i % VAZEL_TRACE_BUFFER_SIZE];
+                    char buf[BUFSIZ];
+
+                    out << (first ? "\n" : ",\n") << "{\"name\":";
+                    writeJsonString(out, event.name);
+                    out << ",\"cat\":";
+                    writeJsonString(out, event.category);
+                    // Chrome expects microseconds
+                    snprintf(buf, sizeof(buf),
+                             ",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,"
+                             "\"ts\":%.3f,\"dur\":%.3f",
+                             slot, event.begin / 1000.0,
+                             event.duration / 1000.0);
+                    out << buf;
+                    if (event.id != noTraceId) {
+                        out << ",\"args\":{\"id\":" << event.id << "}";
+                    }
+                    out << "}";
+                    first = false;
+                }
+            }
+            out << "\n]}\n";
+        }
+
+        void Tracer::writeChromeTrace(const std::string &path) const
+        {
+            std::ofstream file(path);
+
+            if (!file) {
+                throw TraceException("writeChromeTrace: Cannot open " + path);
+            }
+            writeChromeTrace(file);
+            if (!file) {
+                throw TraceException("writeChromeTrace: Cannot write " +
+                                     path);
+            }
+        }
+
+        TraceScope::TraceScope(const char *name, const char *category,
+                               uint64_t id)
+            : _name(name)
+            , _category(category)
+            , _id(id)
+        {
+            if (Tracer::getInstance().isRecording()) {
+                _begin = std::chrono::steady_clock::now();
+            }
+        }
+
+        TraceScope::~TraceScope(void)
+        {
+            if (_begin != std::chrono::steady_clock::time_point()) {
+                Tracer::getInstance().record(_name, _category, _begin,
+                                             std::chrono::steady_clock::now(),
+                                             _id);
+            }
+        }
+
+    } // namespace profiling
+} // namespace vazel
@@ -0,0 +1,137 @@
+/**
+ * src/sim/PerfCounters/PerfCounters.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/sim/PerfCounters/PerfCounters.hpp"
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        PerfSample &PerfSample::operator+=(const PerfSample &other)
+        {
+            cycles += other.cycles;
+            instructions += other.instructions;
+            cacheMisses += other.cacheMisses;
+            branchMisses += other.branchMisses;
+            return *this;
+        }
+
+        PerfSample PerfSample::operator-(const PerfSample &other) const
+        {
+            PerfSample delta;
+
+            delta.cycles       = cycles - other.cycles;
+            delta.instructions = instructions - other.instructions;
+            delta.cacheMisses  = cacheMisses - other.cacheMisses;
+            delta.branchMisses = branchMisses - other.branchMisses;
+            return delta;
+        }
+
+#if defined(__linux__)
+        static int openCounter(uint64_t config, int group)
+        {
+            struct perf_event_attr attr;
+
+            memset(&attr, 0, sizeof(attr));
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof(attr);
+            attr.config         = config;
+            attr.disabled       = group == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP;
+            return static_cast<int>(
+                syscall(__NR_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+        PerfCounters::PerfCounters(void)
+        {
+            _fds.fill(-1);
+#if defined(__linux__)
+            static const std::pair<uint64_t, uint64_t PerfSample::*>
+                counters[] = {
+                    { PERF_COUNT_HW_CPU_CYCLES, &PerfSample::cycles },
+                    { PERF_COUNT_HW_INSTRUCTIONS, &PerfSample::instructions },
+                    { PERF_COUNT_HW_CACHE_MISSES, &PerfSample::cacheMisses },
+                    { PERF_COUNT_HW_BRANCH_MISSES,
+                      &PerfSample::branchMisses },
+                };
+
+            for (const auto &it : counters) {
+                const int fd =
+                    openCounter(it.first, _count == 0 ? -1 : _fds[0]);
+
+                if (fd != -1) {
+                    _fds[_count]    = fd;
+                    _fields[_count] = it.second;
+                    _count++;
+                }
+            }
+            if (_count != 0) {
+                ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        PerfCounters::~PerfCounters(void)
+        {
+#if defined(__linux__)
+            // The members first, the group leader last
+            for (size_t i = _count; i-- != 0;) {
+                close(_fds[i]);
+            }
+#endif
+        }
+
+        bool PerfCounters::isAvailable(void) const
+        {
+            return _count != 0;
+        }
+
+        bool PerfCounters::read(PerfSample &out) const
+        {
+#if defined(__linux__)
+            // PERF_FORMAT_GROUP: the number of counters then their values
+            uint64_t values[1 + 4];
+
+            if (_count == 0 ||
+                ::read(_fds[0], values, sizeof(values)) <
+                    static_cast<ssize_t>((1 + _count) * sizeof(uint64_t))) {
+                return false;
+            }
+            for (size_t i = 0; i != _count; i++) {
+                out.*_fields[i] = values[1 + i];
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    } // namespace sim
+} // namespace vazel
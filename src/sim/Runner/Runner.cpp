@@ -0,0 +1,179 @@
+/**
+ * src/sim/Runner/Runner.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/sim/Runner/Runner.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        double SimulationReport::ticksPerSecond(void) const
+        {
+            const double seconds =
+                std::chrono::duration<double>(elapsed).count();
+
+            return seconds > 0 ? ticks / seconds : 0;
+        }
+
+        std::chrono::nanoseconds SimulationReport::framePercentile(
+            double percent) const
+        {
+            if (frames.empty()) {
+                return std::chrono::nanoseconds::zero();
+            }
+            std::vector<std::chrono::nanoseconds> sorted = frames;
+            const double rank =
+                std::clamp(percent, 0.0, 100.0) / 100 * sorted.size();
+            const size_t index =
+                std::max<size_t>(static_cast<size_t>(std::ceil(rank)), 1) - 1;
+
+            std::nth_element(sorted.begin(), sorted.begin() + index,
+                             sorted.end());
+            return sorted[index];
+        }
+
+        size_t peakResidentMemory(void)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            struct rusage usage;
+
+            if (getrusage(RUSAGE_SELF, &usage) != 0) {
+                return 0;
+            }
+#if defined(__APPLE__)
+            return usage.ru_maxrss;
+#else
+            // Linux reports kilobytes
+            return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+            return 0;
+#endif
+        }
+
+        Runner::Runner(ecs::World &world)
+            : _world(world)
+        {
+        }
+
+        SimulationReport Runner::run(uint64_t ticks)
+        {
+            SimulationReport report;
+            profiling::AllocCounter tickAllocations;
+
+            _indices.clear();
+            _systems.clear();
+            report.frames.reserve(ticks);
+            _perf.reset();
+            if (_perf_enabled) {
+                _perf = std::make_unique<PerfCounters>();
+                if (_perf->isAvailable() == false) {
+                    _perf.reset();
+                }
+            }
+            report.hasPerfCounters = _perf != nullptr;
+            // The probe in place (a FrameWatchdog...) is forwarded to
+            _next = _world.getSystemProbe();
+            _world.setSystemProbe(this);
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                for (uint64_t i = 0; i != ticks; i++) {
+                    const auto begin = std::chrono::steady_clock::now();
+#ifdef VAZEL_ENABLE_ALLOC_TRACKING
+                    profiling::AllocScope scope(tickAllocations);
+#endif
+                    if (_on_tick) {
+                        _on_tick(_world);
+                    }
+                    _world.updateSystem();
+                    report.frames.push_back(
+                        std::chrono::steady_clock::now() - begin);
+                }
+            } catch (...) {
+                _world.setSystemProbe(_next);
+                _next = nullptr;
+                throw;
+            }
+            report.elapsed = std::chrono::steady_clock::now() - start;
+            _world.setSystemProbe(_next);
+            _next = nullptr;
+            report.ticks       = ticks;
+            report.peakMemory  = peakResidentMemory();
+            report.systems     = _systems;
+            report.allocations = tickAllocations.get();
+            return report;
+        }
+
+        void Runner::setOnTick(std::function<void(ecs::World &)> onTick)
+        {
+            _on_tick = onTick;
+        }
+
+        void Runner::enablePerfCounters(bool enabled)
+        {
+            _perf_enabled = enabled;
+        }
+
+        void Runner::onSystemBegin(const ecs::System &system)
+        {
+            if (_next != nullptr) {
+                _next->onSystemBegin(system);
+            }
+            if (_perf != nullptr) {
+                _perf->read(_perf_begin);
+            }
+            _begin = std::chrono::steady_clock::now();
+        }
+
+        void Runner::onSystemEnd(const ecs::System &system)
+        {
+            const std::chrono::nanoseconds elapsed =
+                std::chrono::steady_clock::now() - _begin;
+            PerfSample counters;
+
+            if (_perf != nullptr) {
+                _perf->read(counters);
+            }
+            const auto it = _indices.try_emplace(&system, _systems.size());
+
+            if (it.second) {
+                _systems.emplace_back();
+                _systems.back().tag = system.getTag();
+            }
+            SystemReport &report = _systems[it.first->second];
+
+            report.total += elapsed;
+            report.max      = std::max(report.max, elapsed);
+            report.entities = system.getEntityCount();
+            if (_perf != nullptr) {
+                report.counters += counters - _perf_begin;
+            }
+            if (_next != nullptr) {
+                _next->onSystemEnd(system);
+            }
+        }
+
+    } // namespace sim
+} // namespace vazel
@@ -0,0 +1,242 @@
+/**
+ * src/sim/Scenario/Scenario.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/sim/Scenario/Scenario.hpp"
+
+#include <array>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace vazel
+{
+    namespace sim
+    {
+
+        /**
+         * @brief The operations on SimComponent<I> needed at runtime, indexed
+         * by I
+         *
+         */
+        struct SimComponentOps
+        {
+            ecs::ComponentType (*registerComponent)(ecs::World &,
+                                                    ecs::ComponentStorage);
+            void (*attach)(ecs::World &, ecs::Entity &);
+            float *(*get)(ecs::ComponentManager &, const ecs::Entity &);
+        };
+
+        template <size_t I>
+        static SimComponentOps makeOps(void)
+        {
+            return {
+                [](ecs::World &world, ecs::ComponentStorage storage) {
+                    return world.registerComponent<SimComponent<I>>(storage);
+                },
+                [](ecs::World &world, ecs::Entity &e) {
+                    SimComponent<I> data = { { 1, 1, 1, 1 } };
+
+                    world.attachComponent<SimComponent<I>>(e, data);
+                },
+                [](ecs::ComponentManager &cm, const ecs::Entity &e) {
+                    return cm.getComponent<SimComponent<I>>(e).value;
+                },
+            };
+        }
+
+        template <size_t... I>
+        static std::array<SimComponentOps, sizeof...(I)> makeOpsTable(
+            std::index_sequence<I...>)
+        {
+            return { makeOps<I>()... };
+        }
+
+        static const std::array<SimComponentOps, VAZEL_MAX_COMPONENTS> s_ops =
+            makeOpsTable(std::make_index_sequence<VAZEL_MAX_COMPONENTS>());
+
+        ScenarioException::ScenarioException(const std::string &e)
+        {
+            _e += e;
+        }
+
+        const char *ScenarioException::what(void) const throw()
+        {
+            return _e.c_str();
+        }
+
+        static void checkComponent(const Scenario &scenario, size_t component,
+                                   size_t line)
+        {
+            if (component >= scenario.components) {
+                throw ScenarioException(
+                    "parseScenario: line " + std::to_string(line) +
+                    ": Component " + std::to_string(component) +
+                    " is not declared (see the components directive)");
+            }
+        }
+
+        Scenario parseScenario(std::istream &in)
+        {
+            Scenario scenario;
+            std::string line;
+
+            for (size_t n = 1; std::getline(in, line); n++) {
+                std::istringstream words(line.substr(0, line.find('#')));
+                std::string directive;
+
+                if (!(words >> directive)) {
+                    continue;
+                }
+                bool valid = true;
+                if (directive == "entities") {
+                    valid = static_cast<bool>(words >> scenario.entities);
+                } else if (directive == "components") {
+                    valid = static_cast<bool>(words >> scenario.components) &&
+                            scenario.components != 0 &&
+                            scenario.components <= VAZEL_MAX_COMPONENTS;
+                } else if (directive == "ticks") {
+                    valid = static_cast<bool>(words >> scenario.ticks);
+                } else if (directive == "seed") {
+                    valid = static_cast<bool>(words >> scenario.seed);
+                } else if (directive == "density") {
+                    size_t component = 0;
+                    double ratio     = 0;
+
+                    valid = static_cast<bool>(words >> component >> ratio) &&
+                            ratio >= 0 && ratio <= 1;
+                    if (valid) {
+                        checkComponent(scenario, component, n);
+                        scenario.density.resize(scenario.components, 1);
+                        scenario.density[component] = ratio;
+                    }
+                } else if (directive == "storage") {
+                    size_t component = 0;
+                    std::string name;
+
+                    valid = static_cast<bool>(words >> component >> name);
+                    if (valid) {
+                        checkComponent(scenario, component, n);
+                        scenario.storage.resize(scenario.components,
+                                                ecs::ComponentStorage::Sparse);
+                        if (name == "dense") {
+                            scenario.storage[component] =
+                                ecs::ComponentStorage::Dense;
+                        } else if (name == "paged") {
+                            scenario.storage[component] =
+                                ecs::ComponentStorage::Paged;
+                        } else {
+                            valid = name == "sparse";
+                        }
+                    }
+                } else if (directive == "system") {
+                    ScenarioSystem system;
+                    size_t component = 0;
+
+                    valid = static_cast<bool>(words >> system.tag);
+                    while (valid && words >> component) {
+                        checkComponent(scenario, component, n);
+                        system.components.push_back(component);
+                    }
+                    valid = valid && words.eof() && !system.components.empty();
+                    scenario.systems.push_back(std::move(system));
+                } else {
+                    throw ScenarioException("parseScenario: line " +
+                                            std::to_string(n) +
+                                            ": Unknown directive \"" +
+                                            directive + "\"");
+                }
+                if (valid == false) {
+                    throw ScenarioException("parseScenario: line " +
+                                            std::to_string(n) +
+                                            ": Invalid \"" + directive +
+                                            "\" directive");
+                }
+            }
+            scenario.density.resize(scenario.components, 1);
+            scenario.storage.resize(scenario.components,
+                                    ecs::ComponentStorage::Sparse);
+            return scenario;
+        }
+
+        Scenario loadScenario(const std::string &path)
+        {
+            std::ifstream file(path);
+
+            if (!file) {
+                throw ScenarioException("loadScenario: Cannot open " + path);
+            }
+            return parseScenario(file);
+        }
+
+        void buildScenario(ecs::World &world, const Scenario &scenario)
+        {
+            std::mt19937_64 rng(scenario.seed);
+            std::uniform_real_distribution<double> roll(0, 1);
+            std::vector<ecs::ComponentType> types;
+
+            if (scenario.components > VAZEL_MAX_COMPONENTS) {
+                throw ScenarioException("buildScenario: Too many components");
+            }
+            for (size_t i = 0; i != scenario.components; i++) {
+                const ecs::ComponentStorage storage =
+                    i < scenario.storage.size()
+                        ? scenario.storage[i]
+                        : ecs::ComponentStorage::Sparse;
+
+                types.push_back(s_ops[i].registerComponent(world, storage));
+            }
+            for (size_t i = 0; i != scenario.entities; i++) {
+                ecs::Entity e = world.createEntity();
+
+                for (size_t c = 0; c != scenario.components; c++) {
+                    const double density =
+                        c < scenario.density.size() ? scenario.density[c] : 1;
+
+                    if (density >= 1 || roll(rng) < density) {
+                        s_ops[c].attach(world, e);
+                    }
+                }
+            }
+            for (const auto &it : scenario.systems) {
+                ecs::System system(it.tag);
+                std::vector<float *(*)(ecs::ComponentManager &,
+                                       const ecs::Entity &)>
+                    getters;
+
+                for (const auto &c : it.components) {
+                    system.addDependency(types[c]);
+                    getters.push_back(s_ops[c].get);
+                }
+                system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, getters) {
+                    float *out = getters[0](cm, e);
+
+                    for (size_t i = 1; i < getters.size(); i++) {
+                        const float *in = getters[i](cm, e);
+
+                        for (size_t k = 0; k != 4; k++) {
+                            out[k] += in[k] * 0.5f;
+                        }
+                    }
+                    out[0] += 1;
+                });
+                world.registerSystem(system);
+            }
+        }
+
+    } // namespace sim
+} // namespace vazel
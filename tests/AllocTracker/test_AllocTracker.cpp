@@ -0,0 +1,104 @@
+/**
+ * tests/AllocTracker/test_AllocTracker.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/profiling.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+TEST(AllocTracker, Scopes)
+{
+    vazel::profiling::AllocCounter outer;
+    vazel::profiling::AllocCounter inner;
+
+    {
+        vazel::profiling::AllocScope outerScope(outer);
+        auto a = std::make_unique<int[]>(16);
+        {
+            vazel::profiling::AllocScope innerScope(inner);
+            auto b = std::make_unique<int[]>(8);
+        }
+    }
+    auto c = std::make_unique<int>(0);
+
+    if (vazel::profiling::allocTrackingEnabled() == false) {
+        GTEST_ASSERT_EQ(outer.get().allocations, 0);
+        GTEST_ASSERT_EQ(vazel::profiling::allocTotal().allocations, 0);
+        return;
+    }
+    GTEST_ASSERT_EQ(outer.get().allocations, 2);
+    GTEST_ASSERT_EQ(outer.get().bytes, 24 * sizeof(int));
+    GTEST_ASSERT_EQ(inner.get().allocations, 1);
+    GTEST_ASSERT_EQ(inner.get().bytes, 8 * sizeof(int));
+    outer.reset();
+    GTEST_ASSERT_EQ(outer.get().allocations, 0);
+    GTEST_ASSERT_GE(vazel::profiling::allocTotal().allocations, 3);
+}
+
+TEST(AllocTracker, Sites)
+{
+    vazel::ecs::World world;
+
+    vazel::profiling::resetAllocSites();
+    world.createEntity();
+    for (const auto &it : vazel::profiling::allocSites()) {
+        if (it.first == "World::createEntity") {
+            GTEST_ASSERT_GT(it.second.allocations, 0);
+            return;
+        }
+    }
+    GTEST_ASSERT_FALSE(vazel::profiling::allocTrackingEnabled());
+}
+
+TEST(AllocTracker, SteadyStateUpdate)
+{
+    vazel::ecs::World world;
+    vazel::ecs::System system("steady");
+
+    world.registerComponent<placeholder_component_1>();
+    for (int i = 0; i != 100; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+
+        world.attachComponent<placeholder_component_1>(e);
+    }
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        cm.getComponent<placeholder_component_1>(e);
+    });
+    world.registerSystem(system);
+    world.updateSystem();
+    world.updateSystem();
+    // Once warm, updating the world must not allocate
+    GTEST_ASSERT_EQ(world.getFrameAllocations().allocations, 0);
+
+#if defined(VAZEL_ENABLE_ALLOC_TRACKING) && defined(VAZEL_ENABLE_SYSTEM_STATS)
+    vazel::ecs::System allocating("allocating");
+
+    allocating.addDependency(
+        world.getComponentType<placeholder_component_1>());
+    allocating.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        auto leak = std::make_unique<int>(0);
+    });
+    world.registerSystem(allocating);
+    world.updateSystem();
+    GTEST_ASSERT_EQ(world.getFrameAllocations().allocations, 100);
+    GTEST_ASSERT_EQ(world.systemStats()[0].allocations.allocations, 0);
+    GTEST_ASSERT_EQ(world.systemStats()[1].allocations.allocations, 100);
+#endif
+}
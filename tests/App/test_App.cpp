@@ -0,0 +1,227 @@
+/**
+ * tests/App/test_App.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/App/App.hpp"
+#include "Vazel/ecs/WorldReaper/WorldReaper.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(App, PushAndPopKeepTheSuspendedWorld)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    std::vector<vazel::ecs::Entity> entities;
+    vazel::ecs::Entity pauseEntity;
+    std::vector<std::string> calls;
+    int gameplayUpdates = 0;
+    int pauseUpdates    = 0;
+
+    vazel::core::State gameplay(
+        [&](vazel::core::App &app) {
+            calls.push_back("gameplay init");
+            app.world.registerComponent<int>();
+            for (int i = 0; i != 10; i++) {
+                entities.push_back(app.world.createEntity());
+                app.world.attachComponent<int>(entities.back(), i);
+            }
+        },
+        [&](vazel::core::App &app) {
+            gameplayUpdates++;
+            if (gameplayUpdates == 2) {
+                app.pushState(35);
+            }
+            if (gameplayUpdates == 3) {
+                GTEST_ASSERT_EQ(app.getSuspendedCount(), 0);
+                for (int i = 0; i != 10; i++) {
+                    GTEST_ASSERT_EQ(app.world.getComponent<int>(entities[i]),
+                                    i);
+                }
+                EXPECT_ANY_THROW(app.world.getComponent<int>(pauseEntity));
+                app.stop();
+            }
+        },
+        [&](vazel::core::App &) { calls.push_back("gameplay exit"); }, 34);
+    vazel::core::State pause(
+        [&](vazel::core::App &app) {
+            calls.push_back("pause init");
+            app.world.registerComponent<int>();
+            int value   = 42;
+            pauseEntity = app.world.createEntity();
+            app.world.attachComponent<int>(pauseEntity, value);
+        },
+        [&](vazel::core::App &app) {
+            pauseUpdates++;
+            GTEST_ASSERT_EQ(app.getSuspendedCount(), 1);
+            EXPECT_ANY_THROW(app.world.getComponent<int>(entities[0]));
+            if (pauseUpdates == 2) {
+                app.popState();
+            }
+        },
+        [&](vazel::core::App &) { calls.push_back("pause exit"); }, 35);
+
+    app.registerState(gameplay);
+    app.registerState(pause);
+    app.setState(34);
+    app.run();
+    GTEST_ASSERT_EQ(gameplayUpdates, 3);
+    GTEST_ASSERT_EQ(pauseUpdates, 2);
+    GTEST_ASSERT_EQ(calls, std::vector<std::string>({ "gameplay init",
+                                                      "pause init",
+                                                      "pause exit",
+                                                      "gameplay exit" }));
+}
+
+TEST(App, StopExitsTheSuspendedStates)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    std::vector<vazel::core::StateTag> exits;
+
+    vazel::core::State bottom(
+        [](vazel::core::App &) {},
+        [](vazel::core::App &app) { app.pushState(37); },
+        [&](vazel::core::App &) { exits.push_back(36); }, 36);
+    vazel::core::State top(
+        [](vazel::core::App &) {},
+        [](vazel::core::App &app) {
+            EXPECT_THROW(app.pushState(36), vazel::core::AppException);
+            app.stop();
+        },
+        [&](vazel::core::App &) { exits.push_back(37); }, 37);
+
+    app.registerState(bottom);
+    app.registerState(top);
+    app.setState(36);
+    app.run();
+    GTEST_ASSERT_EQ(exits, std::vector<vazel::core::StateTag>({ 37, 36 }));
+    GTEST_ASSERT_EQ(app.getSuspendedCount(), 0);
+}
+
+TEST(App, AsyncLoadKeepsTheCurrentStateUpdating)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    std::atomic<bool> loaded = false;
+    std::vector<vazel::ecs::Entity> entities;
+    int loadingUpdates = 0;
+    bool initialized   = false;
+
+    vazel::core::State loading(
+        [](vazel::core::App &) {},
+        [&](vazel::core::App &app) {
+            loadingUpdates++;
+            if (loadingUpdates == 1) {
+                app.setStateAsync(39);
+                GTEST_ASSERT_TRUE(app.isLoading());
+            }
+        },
+        [](vazel::core::App &) {}, 38);
+    vazel::core::State gameplay(
+        [&](vazel::core::App &app) {
+            initialized = true;
+            GTEST_ASSERT_FALSE(app.isLoading());
+            for (int i = 0; i != 5; i++) {
+                GTEST_ASSERT_EQ(app.world.getComponent<int>(entities[i]), i);
+            }
+        },
+        [](vazel::core::App &app) { app.stop(); }, [](vazel::core::App &) {},
+        39);
+    gameplay.setOnLoad([&](vazel::ecs::World &world) {
+        world.registerComponent<int>();
+        for (int i = 0; i != 5; i++) {
+            entities.push_back(world.createEntity());
+            world.attachComponent<int>(entities.back(), i);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loaded = true;
+    });
+
+    app.registerState(loading);
+    app.registerState(gameplay);
+    app.clock.setFrameRateLimit(1000);
+    app.setState(38);
+    app.run();
+    app.clock.setFrameRateLimit(0);
+    GTEST_ASSERT_TRUE(loaded);
+    GTEST_ASSERT_TRUE(initialized);
+    GTEST_ASSERT_GT(loadingUpdates, 2);
+}
+
+TEST(App, AsyncLoadRethrows)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    vazel::core::State broken([](vazel::core::App &) {},
+                              [](vazel::core::App &app) { app.stop(); },
+                              [](vazel::core::App &) {}, 40);
+
+    broken.setOnLoad([](vazel::ecs::World &) {
+        throw std::runtime_error("load failed");
+    });
+    app.registerState(broken);
+    app.setStateAsync(40);
+    EXPECT_THROW(app.run(), std::runtime_error);
+    GTEST_ASSERT_FALSE(app.isLoading());
+}
+
+TEST(App, BackgroundTeardown)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    vazel::core::State state(
+        [](vazel::core::App &app) {
+            app.world.registerComponent<int>();
+            for (int i = 0; i != 100; i++) {
+                vazel::ecs::Entity e = app.world.createEntity();
+                app.world.attachComponent<int>(e, i);
+            }
+        },
+        [](vazel::core::App &app) { app.stop(); }, [](vazel::core::App &) {},
+        41);
+
+    app.registerState(state);
+    app.setBackgroundTeardown(true);
+    app.setState(41);
+    app.run();
+    app.setBackgroundTeardown(false);
+    vazel::ecs::WorldReaper::getInstance().wait();
+    GTEST_ASSERT_EQ(vazel::ecs::WorldReaper::getInstance().pending(), 0);
+    EXPECT_ANY_THROW(app.world.getComponentType<int>());
+}
+
+TEST(App, Metrics)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    vazel::profiling::Metrics metrics;
+    int updates = 0;
+    vazel::core::State state(
+        [](vazel::core::App &app) { app.world.createEntity(); },
+        [&updates](vazel::core::App &app) {
+            if (++updates == 3) {
+                app.stop();
+            }
+        },
+        [](vazel::core::App &) {}, 42);
+
+    app.registerState(state);
+    app.setMetrics(&metrics);
+    app.setState(42);
+    app.run();
+    app.setMetrics(nullptr);
+    GTEST_ASSERT_GE(metrics.histogram("vazel_frame_seconds", "").getCount(),
+                    1);
+    GTEST_ASSERT_EQ(metrics.gauge("vazel_keyboard_events_pending", "")
+                        .getValue(),
+                    0);
+}
@@ -0,0 +1,115 @@
+/**
+ * tests/BatchedWorld/test_BatchedWorld.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/BatchedWorld/BatchedWorld.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(BatchedWorld, CreateBatchedWorld)
+{
+    vazel::ecs::BatchedWorld world(16, 50);
+
+    GTEST_ASSERT_EQ(world.environments(), 16);
+    GTEST_ASSERT_EQ(world.capacity(), 50);
+    GTEST_ASSERT_EQ(world.slots(), 800);
+}
+
+TEST(BatchedWorld, ColumnsAreSharedByEnvironments)
+{
+    vazel::ecs::BatchedWorld world(4, 8);
+
+    world.registerComponent<placeholder_position_component>();
+    for (size_t env = 0; env != world.environments(); env++) {
+        vazel::ecs::BatchEntity e = world.createEntity(env);
+        world.attachComponent<placeholder_position_component>(
+            env, e, { (float)env, 0 });
+    }
+    auto column = world.column<placeholder_position_component>();
+    GTEST_ASSERT_EQ(column.size(), world.slots());
+    for (size_t env = 0; env != world.environments(); env++) {
+        GTEST_ASSERT_EQ(column[world.slotOf(env, 0)].x, env);
+    }
+}
+
+TEST(BatchedWorld, SystemUpdatesEveryEnvironment)
+{
+    vazel::ecs::BatchedWorld world(32, 4);
+    vazel::ecs::BatchedSystem system("move");
+
+    world.registerComponent<placeholder_position_component>();
+    world.registerComponent<entity_offsetx_offsety>();
+    for (size_t env = 0; env != world.environments(); env++) {
+        vazel::ecs::BatchEntity moving = world.createEntity(env);
+        vazel::ecs::BatchEntity still  = world.createEntity(env);
+        world.attachComponent<placeholder_position_component>(env, moving);
+        world.attachComponent<entity_offsetx_offsety>(env, moving,
+                                                      { 1, 2 });
+        world.attachComponent<placeholder_position_component>(env, still);
+    }
+    system.addDependency(
+        world.getComponentType<placeholder_position_component>());
+    system.addDependency(world.getComponentType<entity_offsetx_offsety>());
+    system.setOnUpdate(VAZEL_BATCHED_SYSTEM_UPDATE_LAMBDA(w, mask) {
+        auto pos = w.column<placeholder_position_component>();
+        auto off = w.column<entity_offsetx_offsety>();
+
+        for (size_t i = 0; i != mask.size(); i++) {
+            pos[i].x += off[i].ofx * mask[i];
+            pos[i].y += off[i].ofy * mask[i];
+        }
+    });
+    world.registerSystem(system);
+    world.updateSystem();
+    world.updateSystem();
+    for (size_t env = 0; env != world.environments(); env++) {
+        auto &moving =
+            world.getComponent<placeholder_position_component>(env, 0);
+        auto &still =
+            world.getComponent<placeholder_position_component>(env, 1);
+        GTEST_ASSERT_EQ(moving.x, 2);
+        GTEST_ASSERT_EQ(moving.y, 4);
+        GTEST_ASSERT_EQ(still.x, 0);
+    }
+}
+
+TEST(BatchedWorld, ResetEnvironment)
+{
+    vazel::ecs::BatchedWorld world(2, 2);
+
+    world.registerComponent<placeholder_component_1>();
+    world.createEntity(0);
+    world.createEntity(0);
+    world.createEntity(1);
+    EXPECT_THROW(world.createEntity(0), vazel::ecs::BatchedWorldException);
+    world.resetEnvironment(0);
+    GTEST_ASSERT_EQ(world.createEntity(0), 0);
+    EXPECT_THROW(
+        world.getComponent<placeholder_component_1>(1, 0),
+        vazel::ecs::BatchedWorldException);
+    EXPECT_THROW(world.removeEntity(1, 1),
+                 vazel::ecs::BatchedWorldException);
+}
+
+TEST(BatchedWorld, registerSystemWithoutDependency)
+{
+    vazel::ecs::BatchedWorld world(1, 1);
+    vazel::ecs::BatchedSystem system("placeholder_system");
+
+    EXPECT_THROW(world.registerSystem(system),
+                 vazel::ecs::BatchedWorldException);
+}
@@ -0,0 +1,152 @@
+/**
+ * tests/BenchCompare/test_BenchCompare.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../bench/compare/Compare.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+static JsonValue parse(const std::string &text)
+{
+    std::istringstream in(text);
+
+    return parseJson(in);
+}
+
+static BenchResults results(const std::string &benchmarks)
+{
+    std::istringstream in("{\"benchmarks\": [" + benchmarks + "]}");
+
+    return parseResults(in, "real_time");
+}
+
+TEST(BenchCompare, ParseJson)
+{
+    const JsonValue doc = parse(" {\"a\": [1, -2.5e3, true, false, null],"
+                                " \"b\": {\"c\": {\"d\": []}},"
+                                " \"e\": \"q\\\"\\\\\\/\\n\\t\\u0041\"} ");
+
+    GTEST_ASSERT_EQ(doc.type, JsonValue::Type::Object);
+    const JsonValue *a = doc.get("a");
+    GTEST_ASSERT_NE(a, nullptr);
+    GTEST_ASSERT_EQ(a->array.size(), 5);
+    GTEST_ASSERT_EQ(a->array[1].number, -2500);
+    GTEST_ASSERT_TRUE(a->array[2].boolean);
+    GTEST_ASSERT_EQ(a->array[4].type, JsonValue::Type::Null);
+    const JsonValue *d = doc.get("b")->get("c")->get("d");
+    GTEST_ASSERT_NE(d, nullptr);
+    GTEST_ASSERT_EQ(d->type, JsonValue::Type::Array);
+    GTEST_ASSERT_EQ(doc.get("e")->string, "q\"\\/\n\tA");
+    GTEST_ASSERT_EQ(doc.get("missing"), nullptr);
+}
+
+TEST(BenchCompare, MalformedJson)
+{
+    const char *documents[] = { "",          "{",         "{\"a\" 1}",
+                                "[1, 2",     "[1,]",      "\"abc",
+                                "tru",       "{} {}",     "@",
+                                "\"\\u00\"" };
+
+    for (const char *it : documents) {
+        EXPECT_THROW(parse(it), JsonException) << it;
+    }
+    std::istringstream empty("{\"context\": {}}");
+    EXPECT_THROW(parseResults(empty, "real_time"), JsonException);
+    EXPECT_THROW(results("{\"name\": \"BM_A\", \"real_time\": 1, "
+                         "\"time_unit\": \"h\"}"),
+                 JsonException);
+}
+
+TEST(BenchCompare, ParseResults)
+{
+    const BenchResults res = results(
+        "{\"name\": \"BM_A\", \"real_time\": 2, \"time_unit\": \"us\"},"
+        "{\"name\": \"BM_A\", \"real_time\": 4, \"time_unit\": \"us\"},"
+        "{\"name\": \"BM_B\", \"real_time\": 1.5, \"time_unit\": \"ms\"},"
+        "{\"name\": \"BM_C\", \"real_time\": 1, \"time_unit\": \"s\"},"
+        "{\"name\": \"BM_D\", \"real_time\": 7},"
+        "{\"run_name\": \"BM_E\", \"run_type\": \"iteration\","
+        " \"real_time\": 100},"
+        "{\"run_name\": \"BM_E\", \"run_type\": \"aggregate\","
+        " \"aggregate_name\": \"median\", \"real_time\": 3},"
+        "{\"run_name\": \"BM_E\", \"run_type\": \"aggregate\","
+        " \"aggregate_name\": \"mean\", \"real_time\": 50},"
+        "{\"name\": \"BM_F\", \"real_time\": 1, \"error_occurred\": true}");
+
+    GTEST_ASSERT_EQ(res.size(), 5);
+    GTEST_ASSERT_EQ(res.at("BM_A").time(), 3000);
+    GTEST_ASSERT_EQ(res.at("BM_B").time(), 1.5e6);
+    GTEST_ASSERT_EQ(res.at("BM_C").time(), 1e9);
+    GTEST_ASSERT_EQ(res.at("BM_D").time(), 7);
+    GTEST_ASSERT_EQ(res.at("BM_E").time(), 3);
+}
+
+TEST(BenchCompare, Thresholds)
+{
+    std::istringstream in("# comment\n"
+                          "BM_ 10\n"
+                          "BM_Join 50 # noisy\n");
+    std::istringstream invalid("BM_ ten\n");
+    const std::vector<Threshold> thresholds = parseThresholds(in, "t");
+
+    GTEST_ASSERT_EQ(thresholds.size(), 2);
+    GTEST_ASSERT_EQ(thresholdOf("BM_JoinRare", thresholds, 5), 50);
+    GTEST_ASSERT_EQ(thresholdOf("BM_Attach", thresholds, 5), 10);
+    GTEST_ASSERT_EQ(thresholdOf("scenario", thresholds, 5), 5);
+    EXPECT_THROW(parseThresholds(invalid, "t"), JsonException);
+}
+
+TEST(BenchCompare, Gate)
+{
+    const BenchResults baseline = results(
+        "{\"name\": \"BM_A\", \"real_time\": 100},"
+        "{\"name\": \"BM_B\", \"real_time\": 100},"
+        "{\"name\": \"BM_C\", \"real_time\": 100}");
+    const BenchResults faster = results(
+        "{\"name\": \"BM_A\", \"real_time\": 104},"
+        "{\"name\": \"BM_B\", \"real_time\": 80},"
+        "{\"name\": \"BM_C\", \"real_time\": 100},"
+        "{\"name\": \"BM_D\", \"real_time\": 1}");
+    const BenchResults slower = results(
+        "{\"name\": \"BM_A\", \"real_time\": 106},"
+        "{\"name\": \"BM_B\", \"real_time\": 100},"
+        "{\"name\": \"BM_C\", \"real_time\": 100}");
+    const BenchResults partial = results(
+        "{\"name\": \"BM_A\", \"real_time\": 100}");
+
+    const std::vector<BenchComparison> same =
+        compareResults(baseline, faster, {}, 5);
+    GTEST_ASSERT_EQ(same.size(), 4);
+    GTEST_ASSERT_EQ(same[0].status, BenchStatus::Same);
+    GTEST_ASSERT_EQ(same[1].status, BenchStatus::Improved);
+    GTEST_ASSERT_EQ(same[3].status, BenchStatus::New);
+    GTEST_ASSERT_TRUE(passesGate(same, false));
+
+    const std::vector<BenchComparison> regression =
+        compareResults(baseline, slower, {}, 5);
+    GTEST_ASSERT_EQ(regression[0].status, BenchStatus::Regression);
+    GTEST_ASSERT_FALSE(passesGate(regression, true));
+    GTEST_ASSERT_TRUE(
+        passesGate(compareResults(baseline, slower, { { "BM_A", 10 } }, 5),
+                   false));
+
+    const std::vector<BenchComparison> missing =
+        compareResults(baseline, partial, {}, 5);
+    GTEST_ASSERT_EQ(missing[1].status, BenchStatus::Missing);
+    GTEST_ASSERT_FALSE(passesGate(missing, false));
+    GTEST_ASSERT_TRUE(passesGate(missing, true));
+}
@@ -0,0 +1,116 @@
+/**
+ * tests/ComponentPool/test_ComponentPool.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/ComponentPool/ComponentPool.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+using vazel::ecs::ComponentStorage;
+
+static void checkPool(ComponentStorage storage)
+{
+    vazel::ecs::ComponentPool pool;
+    std::set<vazel::ecs::EntityIndex> visited;
+
+    pool.configure(storage, vazel::ecs::getComponentVTable<std::string>());
+    // Enough values to grow the pool and to cover several pages
+    for (vazel::ecs::EntityIndex i = 0; i != 1000; i++) {
+        pool.emplace<std::string>(i * 7, std::to_string(i));
+    }
+    GTEST_ASSERT_EQ(pool.size(), 1000);
+    GTEST_ASSERT_TRUE(pool.contains(693));
+    GTEST_ASSERT_FALSE(pool.contains(694));
+    GTEST_ASSERT_FALSE(pool.contains(1000000));
+    GTEST_ASSERT_EQ(*static_cast<std::string *>(pool.find(693)), "99");
+
+    GTEST_ASSERT_TRUE(pool.erase(0));
+    GTEST_ASSERT_FALSE(pool.erase(0));
+    GTEST_ASSERT_TRUE(pool.erase(700));
+    GTEST_ASSERT_EQ(pool.size(), 998);
+    for (vazel::ecs::EntityIndex i = 1; i != 1000; i++) {
+        const auto *value = static_cast<std::string *>(pool.find(i * 7));
+
+        if (i == 100) {
+            GTEST_ASSERT_EQ(value, nullptr);
+            continue;
+        }
+        GTEST_ASSERT_NE(value, nullptr);
+        GTEST_ASSERT_EQ(*value, std::to_string(i));
+    }
+    pool.forEach([&visited](vazel::ecs::EntityIndex index) {
+        visited.insert(index);
+    });
+    GTEST_ASSERT_EQ(visited.size(), 998);
+    GTEST_ASSERT_EQ(visited.count(700), 0);
+    GTEST_ASSERT_GE(pool.getValueBytes(), 998 * sizeof(std::string));
+    GTEST_ASSERT_GT(pool.getIndexBytes(), 0);
+
+    pool.clear();
+    GTEST_ASSERT_EQ(pool.size(), 0);
+    GTEST_ASSERT_EQ(pool.getValueBytes(), 0);
+    GTEST_ASSERT_FALSE(pool.contains(693));
+    pool.emplace<std::string>(3, "reused");
+    GTEST_ASSERT_EQ(*static_cast<std::string *>(pool.find(3)), "reused");
+}
+
+TEST(ComponentPool, Dense)
+{
+    checkPool(ComponentStorage::Dense);
+}
+
+TEST(ComponentPool, Sparse)
+{
+    checkPool(ComponentStorage::Sparse);
+}
+
+TEST(ComponentPool, Paged)
+{
+    vazel::ecs::ComponentPool pool;
+
+    checkPool(ComponentStorage::Paged);
+    pool.configure(ComponentStorage::Paged,
+                   vazel::ecs::getComponentVTable<int>());
+    pool.emplace<int>(10000000, 1);
+    // A single page covers the index
+    GTEST_ASSERT_LT(pool.getIndexBytes(), 10000000 / 64);
+}
+
+TEST(ComponentPool, CopyAStoredValueWhileGrowing)
+{
+    for (auto storage : { ComponentStorage::Dense, ComponentStorage::Sparse,
+                          ComponentStorage::Paged }) {
+        vazel::ecs::ComponentPool pool;
+        // Longer than the small string buffer, so the copy reads the heap
+        const std::string name(64, 'n');
+
+        pool.configure(storage,
+                       vazel::ecs::getComponentVTable<std::string>());
+        for (vazel::ecs::EntityIndex i = 0; i != 8; i++) {
+            pool.emplace<std::string>(i, name);
+        }
+        // The pool is full, the copied value moves when it grows
+        const size_t bytes = pool.getValueBytes();
+        pool.emplace<std::string>(
+            8, *static_cast<std::string *>(pool.find(0)));
+
+        GTEST_ASSERT_GT(pool.getValueBytes(), bytes);
+        GTEST_ASSERT_EQ(*static_cast<std::string *>(pool.find(8)), name);
+        GTEST_ASSERT_EQ(*static_cast<std::string *>(pool.find(0)), name);
+    }
+}
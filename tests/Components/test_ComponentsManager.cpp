@@ -225,3 +225,65 @@ TEST(ComponentUsage, getComponentWithoutRegisteredEntity)
     std::cerr << "Error: Got no exception" << std::endl;
     GTEST_FAIL();
 }
+
+TEST(ComponentUsage, joinStorages)
+{
+    vazel::ecs::EntityManager em;
+    vazel::ecs::ComponentManager cm(em);
+    std::vector<vazel::ecs::Entity> entities;
+    size_t count = 0;
+
+    cm.registerComponent<placeholder_position_component>(
+        vazel::ecs::ComponentStorage::Dense);
+    cm.registerComponent<entity_offsetx_offsety>(
+        vazel::ecs::ComponentStorage::Paged);
+    for (size_t i = 0; i != 1000; i++) {
+        placeholder_position_component position = { float(i), 0 };
+
+        entities.push_back(em.createEntity());
+        cm.attachComponent(entities[i], position);
+        if (i % 100 == 0) {
+            cm.attachComponent<entity_offsetx_offsety>(entities[i]);
+        }
+    }
+    cm.detachComponent<entity_offsetx_offsety>(entities[100]);
+    cm.onEntityDestroy(entities[200]);
+    em.destroyEntity(entities[200]);
+    cm.join<placeholder_position_component, entity_offsetx_offsety>(
+        [&](const vazel::ecs::Entity &e, placeholder_position_component &p,
+            entity_offsetx_offsety &o) {
+            GTEST_ASSERT_EQ(e, entities[static_cast<size_t>(p.x)]);
+            o.ofx = p.x;
+            count++;
+        });
+    GTEST_ASSERT_EQ(count, 8);
+    GTEST_ASSERT_EQ(cm.getComponent<entity_offsetx_offsety>(entities[900]).ofx,
+                    900);
+    GTEST_ASSERT_EQ(cm.getComponentCount(
+                        cm.getComponentType<entity_offsetx_offsety>()),
+                    8);
+}
+
+TEST(ComponentUsage, ownedOrSharedEntityManager)
+{
+    vazel::ecs::ComponentManager owner;
+    vazel::ecs::EntityManager em;
+    vazel::ecs::ComponentManager shared(em);
+    vazel::ecs::Entity e = em.createEntity();
+    vazel::ecs::Entity unknown;
+
+    owner.onEntityCreate(e);
+    EXPECT_THROW(owner.onEntityCreate(e),
+                 vazel::ecs::ComponentManagerException);
+    shared.onEntityCreate(e);
+    EXPECT_THROW(shared.onEntityCreate(unknown),
+                 vazel::ecs::ComponentManagerException);
+    owner.attachComponent<placeholder_component_1>(e);
+    shared.attachComponent<placeholder_component_1>(e);
+    owner.onEntityDestroy(e);
+    EXPECT_THROW(owner.getComponent<placeholder_component_1>(e),
+                 vazel::ecs::ComponentManagerException);
+    // The shared EntityManager still has the entity
+    shared.getComponent<placeholder_component_1>(e);
+    GTEST_ASSERT_EQ(em.getMap().size(), 1);
+}
@@ -35,6 +35,6 @@ TEST(EntitiesGeneration, MakeSureThereIsNoCollisions)
     for (size_t i = 0; i != 100000; i++) {
         e = vazel::ecs::Entity();
         GTEST_ASSERT_EQ(entities.find(e), entities.end());
-        entities.insert(std::make_pair(e, vazel::ecs::ComponentSignature()));
+        entities.insert(std::make_pair(e, vazel::ecs::EntityRecord()));
     }
 }
@@ -111,3 +111,58 @@ TEST(EntityManager,
         manager.destroyEntity(entity);
     }
 }
+
+TEST(EntityManager, join)
+{
+    vazel::ecs::EntityManager manager;
+    std::vector<vazel::ecs::Entity> entities;
+    vazel::ecs::ComponentSignature signature;
+    std::vector<vazel::ecs::Entity> joined;
+
+    for (size_t i = 0; i != 200; i++) {
+        entities.push_back(manager.createEntity());
+        manager.setComponent(entities.back(), 0, true);
+        if (i % 3 == 0) {
+            manager.setComponent(entities.back(), 1, true);
+        }
+    }
+    // Written through the reference, indexed before the next join
+    manager.getSignature(entities[1]).set(1, true);
+    manager.setComponent(entities[3], 0, false);
+    signature.set(0, true);
+    signature.set(1, true);
+    manager.join(signature, [&joined](const vazel::ecs::Entity &e) {
+        joined.push_back(e);
+    });
+    GTEST_ASSERT_EQ(joined.size(), 67);
+    GTEST_ASSERT_EQ(joined[0], entities[0]);
+    GTEST_ASSERT_EQ(joined[1], entities[1]);
+    GTEST_ASSERT_EQ(joined[2], entities[6]);
+}
+
+TEST(EntityManager, indexReuse)
+{
+    vazel::ecs::EntityManager manager;
+    vazel::ecs::Entity first  = manager.createEntity();
+    vazel::ecs::Entity second = manager.createEntity();
+    const vazel::ecs::EntityIndex index = manager.getIndex(first);
+    size_t count                        = 0;
+
+    manager.setComponent(first, 2, true);
+    manager.destroyEntity(first);
+    GTEST_ASSERT_TRUE(manager.getComponentSet(2).empty());
+    vazel::ecs::Entity third = manager.createEntity();
+
+    GTEST_ASSERT_EQ(manager.getIndex(third), index);
+    GTEST_ASSERT_EQ(manager.getIndexCount(), 2);
+    GTEST_ASSERT_TRUE(manager.getSignature(third).none());
+    manager.join(vazel::ecs::ComponentSignature(),
+                 [&count](const vazel::ecs::Entity &) { count++; });
+    GTEST_ASSERT_EQ(count, 2);
+    EXPECT_THROW(manager.destroyEntity(first),
+                 vazel::ecs::EntityManagerExceptionFindEntityError);
+    // An unknown entity is added by setSignature, on a new index
+    manager.setSignature(first, {});
+    GTEST_ASSERT_EQ(manager.getIndex(first), 2);
+    (void)second;
+}
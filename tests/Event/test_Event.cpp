@@ -0,0 +1,103 @@
+/**
+ * tests/Event/test_Event.cpp
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/Event/Event.hpp"
+#include "Vazel/core/Event/RingBuffer.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(RingBuffer, PushPopInOrder)
+{
+    vazel::core::RingBuffer<int, 4> buffer;
+    int value = 0;
+
+    GTEST_ASSERT_EQ(buffer.pop(value), false);
+    for (int i = 0; i != 4; i++) {
+        GTEST_ASSERT_EQ(buffer.push(i), true);
+    }
+    GTEST_ASSERT_EQ(buffer.push(4), false);
+    GTEST_ASSERT_EQ(buffer.size(), 4);
+    for (int i = 0; i != 4; i++) {
+        GTEST_ASSERT_EQ(buffer.pop(value), true);
+        GTEST_ASSERT_EQ(value, i);
+    }
+    GTEST_ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBuffer, DrainWrapsAround)
+{
+    vazel::core::RingBuffer<int, 8> buffer;
+    std::array<int, 8> out;
+
+    for (int round = 0; round != 5; round++) {
+        for (int i = 0; i != 6; i++) {
+            buffer.push(round * 10 + i);
+        }
+        GTEST_ASSERT_EQ(buffer.drain(std::span<int>(out.data(), 4)), 4);
+        GTEST_ASSERT_EQ(out[0], round * 10);
+        GTEST_ASSERT_EQ(buffer.drain(out), 2);
+        GTEST_ASSERT_EQ(out[1], round * 10 + 5);
+    }
+}
+
+TEST(RingBuffer, ManyProducers)
+{
+    vazel::core::RingBuffer<int, 1024> buffer;
+    std::vector<std::thread> producers;
+    std::vector<int> counts(4, 0);
+    std::array<int, 64> out;
+    size_t received = 0;
+
+    for (int p = 0; p != 4; p++) {
+        producers.emplace_back([&buffer, p] {
+            for (int i = 0; i != 5000; i++) {
+                while (buffer.push(p * 10000 + i) == false) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    while (received != 20000) {
+        size_t n = buffer.drain(out);
+        for (size_t i = 0; i != n; i++) {
+            int producer = out[i] / 10000;
+            // Events of one producer keep their order
+            GTEST_ASSERT_EQ(out[i] % 10000, counts[producer]);
+            counts[producer]++;
+        }
+        received += n;
+    }
+    for (auto &it : producers) {
+        it.join();
+    }
+}
+
+TEST(Keyboard, PushAndDrain)
+{
+    std::array<vazel::core::Keyboard::Input, 16> events;
+    vazel::core::Keyboard::Input input;
+
+    vazel::core::Keyboard::drain(events);
+    vazel::core::Keyboard::pushEvent(vazel::core::Keyboard::A);
+    vazel::core::Keyboard::pushEvent(vazel::core::Keyboard::Escape);
+    GTEST_ASSERT_EQ(vazel::core::Keyboard::pending(), 2);
+    GTEST_ASSERT_EQ(vazel::core::Keyboard::poll(input), true);
+    GTEST_ASSERT_EQ(input, vazel::core::Keyboard::A);
+    GTEST_ASSERT_EQ(vazel::core::Keyboard::drain(events), 1);
+    GTEST_ASSERT_EQ(events[0], vazel::core::Keyboard::Escape);
+    GTEST_ASSERT_EQ(vazel::core::Keyboard::poll(input), false);
+}
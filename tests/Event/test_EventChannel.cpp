@@ -0,0 +1,93 @@
+/**
+ * tests/Event/test_EventChannel.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+struct collision_event
+{
+    vazel::UUID a;
+    vazel::UUID b;
+};
+
+TEST(EventChannel, EventsAreReadableOnTheNextFrame)
+{
+    vazel::ecs::EventChannel<int> channel;
+
+    channel.send(1);
+    channel.emplace(2);
+    GTEST_ASSERT_EQ(channel.read().size(), 0);
+    channel.flip();
+    GTEST_ASSERT_EQ(channel.read().size(), 2);
+    GTEST_ASSERT_EQ(channel.read()[0], 1);
+    GTEST_ASSERT_EQ(channel.read()[1], 2);
+    channel.flip();
+    GTEST_ASSERT_EQ(channel.read().size(), 0);
+}
+
+TEST(EventChannel, SendFromManyThreads)
+{
+    vazel::ecs::EventChannel<int> channel;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t != 4; t++) {
+        threads.emplace_back([&channel] {
+            for (int i = 0; i != 1000; i++) {
+                channel.send(i);
+            }
+        });
+    }
+    for (auto &it : threads) {
+        it.join();
+    }
+    channel.flip();
+    GTEST_ASSERT_EQ(channel.read().size(), 4000);
+}
+
+TEST(EventChannel, SystemsTalkThroughTheWorld)
+{
+    vazel::ecs::World world;
+    vazel::ecs::System sender("sender");
+    vazel::ecs::System receiver("receiver");
+    size_t received = 0;
+
+    world.registerComponent<placeholder_component_1>();
+    vazel::ecs::Entity e = world.createEntity();
+    world.attachComponent<placeholder_component_1>(e);
+
+    auto &channel = world.events<collision_event>();
+    sender.addDependency(world.getComponentType<placeholder_component_1>());
+    sender.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, &channel) {
+        channel.send({ e.getId(), e.getId() });
+    });
+    receiver.addDependency(world.getComponentType<placeholder_component_1>());
+    receiver.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, &world,
+                                                    &received) {
+        received += world.events<collision_event>().read().size();
+    });
+    world.registerSystem(sender);
+    world.registerSystem(receiver);
+
+    world.updateSystem();
+    GTEST_ASSERT_EQ(received, 0);
+    world.updateSystem();
+    GTEST_ASSERT_EQ(received, 1);
+    GTEST_ASSERT_EQ(&world.events<collision_event>(), &channel);
+}
@@ -0,0 +1,123 @@
+/**
+ * tests/Event/test_InputRecorder.cpp
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/App/App.hpp"
+#include "Vazel/core/Event/InputRecorder.hpp"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using Keyboard = vazel::core::Keyboard;
+
+static void _flushKeyboard(void)
+{
+    Keyboard::Input input;
+
+    while (Keyboard::poll(input)) {
+    }
+}
+
+TEST(InputRecorder, SaveAndLoad)
+{
+    vazel::core::InputRecorder recorder;
+    const std::string path = "vazel_test_input_log.bin";
+
+    recorder.setFrame(3);
+    recorder.record(Keyboard::A);
+    recorder.record(Keyboard::Unknown);
+    recorder.setFrame(700);
+    recorder.record(Keyboard::Pause);
+    recorder.save(path, 1000);
+
+    vazel::core::InputReplay replay(path);
+    std::remove(path.c_str());
+    GTEST_ASSERT_EQ(replay.getEndFrame(), 1000);
+    GTEST_ASSERT_EQ(replay.getRecords().size(), 3);
+    GTEST_ASSERT_EQ(replay.getRecords()[0].frame, 3);
+    GTEST_ASSERT_EQ(replay.getRecords()[1].input, Keyboard::Unknown);
+    GTEST_ASSERT_EQ(replay.getRecords()[2].frame, 700);
+    GTEST_ASSERT_EQ(replay.getRecords()[2].input, Keyboard::Pause);
+}
+
+TEST(InputRecorder, InvalidLog)
+{
+    EXPECT_THROW(vazel::core::InputReplay("vazel_missing_input_log.bin"),
+                 vazel::core::InputLogException);
+}
+
+TEST(InputRecorder, RecordAndReplayThroughApp)
+{
+    const std::string path = "vazel_test_app_input_log.bin";
+    vazel::core::App &app  = vazel::core::App::getInstance();
+    vazel::core::InputRecorder recorder;
+    std::vector<std::pair<uint64_t, Keyboard::Input>> seen;
+
+    auto update = [&seen](vazel::core::App &app) {
+        Keyboard::Input input;
+
+        while (Keyboard::poll(input)) {
+            seen.emplace_back(app.getFrame(), input);
+        }
+        if (app.getFrame() == 2) {
+            Keyboard::pushEvent(Keyboard::B);
+        }
+        if (app.getFrame() == 5) {
+            Keyboard::pushEvent(Keyboard::C);
+            Keyboard::pushEvent(Keyboard::D);
+        }
+        if (app.getFrame() == 9) {
+            app.stop();
+        }
+    };
+    vazel::core::State state([](vazel::core::App &) {}, update,
+                             [](vazel::core::App &) {}, 31);
+
+    _flushKeyboard();
+    app.registerState(state);
+    app.setInputRecorder(&recorder);
+    app.setState(31);
+    const uint64_t start = app.getFrame();
+    app.run();
+    app.setInputRecorder(nullptr);
+    recorder.save(path, app.getFrame());
+    GTEST_ASSERT_EQ(seen.size(), 3);
+    GTEST_ASSERT_EQ(seen[0].first, start + 3);
+    GTEST_ASSERT_EQ(seen[1].first, start + 6);
+
+    // During the replay nothing is pushed by the state itself
+    auto recorded = seen;
+    vazel::core::InputReplay replay(path);
+    std::remove(path.c_str());
+    seen.clear();
+    vazel::core::State replayed(
+        [](vazel::core::App &) {},
+        [&seen](vazel::core::App &app) {
+            Keyboard::Input input;
+
+            while (Keyboard::poll(input)) {
+                seen.emplace_back(app.getFrame(), input);
+            }
+        },
+        [](vazel::core::App &) {}, 32);
+    app.registerState(replayed);
+    app.setInputReplay(&replay);
+    app.setState(32);
+    app.run();
+    app.setInputReplay(nullptr);
+    GTEST_ASSERT_EQ(seen.size(), recorded.size());
+    for (size_t i = 0; i != seen.size(); i++) {
+        GTEST_ASSERT_EQ(seen[i].second, recorded[i].second);
+    }
+}
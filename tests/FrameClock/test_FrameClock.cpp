@@ -0,0 +1,117 @@
+/**
+ * tests/FrameClock/test_FrameClock.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/App/App.hpp"
+#include "Vazel/core/FrameClock/FrameClock.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(FrameClock, VariableStep)
+{
+    vazel::core::FrameClock clock;
+
+    std::this_thread::sleep_for(2ms);
+    GTEST_ASSERT_EQ(clock.beginFrame(), 1);
+    GTEST_ASSERT_GE(clock.getFrameTime(), 2ms);
+    GTEST_ASSERT_GE(clock.getDeltaTime(), 0.002);
+    GTEST_ASSERT_EQ(clock.getInterpolation(), 0);
+}
+
+TEST(FrameClock, FixedStepCatchUp)
+{
+    vazel::core::FrameClock clock;
+
+    clock.setFixedStep(2ms);
+    clock.reset();
+    std::this_thread::sleep_for(5ms);
+    const unsigned steps = clock.beginFrame();
+    GTEST_ASSERT_GE(steps, 2);
+    GTEST_ASSERT_LE(steps, 5);
+    GTEST_ASSERT_EQ(clock.getDeltaTime(), 0.002);
+    GTEST_ASSERT_LT(clock.getInterpolation(), 1);
+}
+
+TEST(FrameClock, MaxStepsDropsTheRest)
+{
+    vazel::core::FrameClock clock;
+
+    clock.setFixedStep(1ms);
+    clock.setMaxSteps(3);
+    clock.reset();
+    std::this_thread::sleep_for(10ms);
+    GTEST_ASSERT_EQ(clock.beginFrame(), 3);
+    GTEST_ASSERT_GE(clock.getDroppedSteps(), 7);
+    GTEST_ASSERT_LT(clock.getInterpolation(), 1);
+}
+
+TEST(FrameClock, FixedStepSleepsUntilTheNextStep)
+{
+    vazel::core::FrameClock clock;
+    unsigned steps = 0;
+
+    clock.setFixedStep(5ms);
+    clock.reset();
+    const auto start = std::chrono::steady_clock::now();
+    while (steps < 4) {
+        steps += clock.beginFrame();
+        clock.endFrame();
+    }
+    GTEST_ASSERT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(FrameClock, FrameRateLimit)
+{
+    vazel::core::FrameClock clock;
+
+    clock.setFrameRateLimit(200);
+    clock.reset();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != 4; i++) {
+        GTEST_ASSERT_EQ(clock.beginFrame(), 1);
+        clock.endFrame();
+    }
+    GTEST_ASSERT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
+
+TEST(FrameClock, AppFixedStep)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    std::vector<double> deltas;
+
+    vazel::core::State state(
+        [](vazel::core::App &) {},
+        [&deltas](vazel::core::App &app) {
+            deltas.push_back(app.world.getDeltaTime());
+            if (deltas.size() == 5) {
+                app.stop();
+            }
+        },
+        [](vazel::core::App &) {}, 33);
+
+    app.clock.setFixedStep(1ms);
+    app.registerState(state);
+    app.setState(33);
+    app.run();
+    app.clock.setFixedStep(0ms);
+    GTEST_ASSERT_EQ(deltas.size(), 5);
+    for (const auto &it : deltas) {
+        GTEST_ASSERT_EQ(it, 0.001);
+    }
+}
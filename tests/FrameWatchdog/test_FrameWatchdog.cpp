@@ -0,0 +1,174 @@
+/**
+ * tests/FrameWatchdog/test_FrameWatchdog.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/core/App/App.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+struct counting_probe : public vazel::ecs::SystemProbe
+{
+    int begins = 0;
+    int ends   = 0;
+
+    void onSystemBegin(const vazel::ecs::System &) override
+    {
+        begins++;
+    }
+
+    void onSystemEnd(const vazel::ecs::System &) override
+    {
+        ends++;
+    }
+};
+
+static std::chrono::nanoseconds runFrame(vazel::core::FrameWatchdog &watchdog,
+                                         vazel::ecs::World &world,
+                                         uint64_t frame)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    watchdog.beginFrame(world);
+    world.updateSystem();
+    const std::chrono::nanoseconds elapsed =
+        std::chrono::steady_clock::now() - begin;
+    watchdog.endFrame(world, frame, elapsed);
+    return elapsed;
+}
+
+TEST(FrameWatchdog, CapturesTheSlowFrame)
+{
+    vazel::core::FrameWatchdog watchdog;
+    vazel::ecs::World world;
+    vazel::ecs::System fast("fast");
+    vazel::ecs::System slow("slow");
+    counting_probe probe;
+    bool sleep = false;
+
+    world.registerComponent<placeholder_component_1>();
+    fast.addDependency(world.getComponentType<placeholder_component_1>());
+    slow.addDependency(world.getComponentType<placeholder_component_1>());
+    slow.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(, , &sleep) {
+        if (sleep) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    world.registerSystem(fast);
+    world.registerSystem(slow);
+    vazel::ecs::Entity e = world.createEntity();
+    world.attachComponent<placeholder_component_1>(e);
+
+    GTEST_ASSERT_FALSE(watchdog.isEnabled());
+    watchdog.setBudget(std::chrono::milliseconds(4));
+    world.setSystemProbe(&probe);
+    watchdog.attach(world);
+    runFrame(watchdog, world, 0);
+    GTEST_ASSERT_EQ(watchdog.getSlowFrameCount(), 0);
+
+    sleep = true;
+    watchdog.beginFrame(world);
+    vazel::ecs::Entity other = world.createEntity();
+    world.attachComponent<placeholder_component_1>(other);
+    world.detachComponent<placeholder_component_1>(e);
+    world.updateSystem();
+    watchdog.endFrame(world, 1, std::chrono::milliseconds(6));
+    watchdog.detach(world);
+
+    GTEST_ASSERT_EQ(world.getSystemProbe(), &probe);
+    GTEST_ASSERT_EQ(probe.begins, 4);
+    GTEST_ASSERT_EQ(probe.ends, 4);
+    GTEST_ASSERT_EQ(watchdog.getSlowFrameCount(), 1);
+    const vazel::core::SlowFrame report = watchdog.getReports()[0];
+
+    GTEST_ASSERT_EQ(report.frame, 1);
+    GTEST_ASSERT_EQ(report.budget, std::chrono::milliseconds(4));
+    GTEST_ASSERT_EQ(report.systems.size(), 2);
+    GTEST_ASSERT_EQ(report.systems[1].tag, "slow");
+    GTEST_ASSERT_EQ(report.systems[1].entities, 1);
+    GTEST_ASSERT_GE(report.systems[1].duration,
+                    std::chrono::milliseconds(5));
+    GTEST_ASSERT_EQ(report.changes.entitiesCreated, 1);
+    GTEST_ASSERT_EQ(report.changes.componentsAttached, 1);
+    GTEST_ASSERT_EQ(report.changes.componentsDetached, 1);
+
+    std::ostringstream out;
+    out << report;
+    GTEST_ASSERT_EQ(out.str().find("frame 1: "), 0);
+    GTEST_ASSERT_LT(out.str().find("slow"), out.str().find("fast"));
+}
+
+TEST(FrameWatchdog, KeepsTheLastFrames)
+{
+    vazel::core::FrameWatchdog watchdog;
+    vazel::ecs::World world;
+    const std::string path = "vazel_test_slow_frames.txt";
+
+    watchdog.setBudget(std::chrono::nanoseconds(1), 2);
+    for (uint64_t i = 0; i != 5; i++) {
+        watchdog.beginFrame(world);
+        watchdog.endFrame(world, i, std::chrono::milliseconds(1));
+    }
+    const std::vector<vazel::core::SlowFrame> reports = watchdog.getReports();
+
+    GTEST_ASSERT_EQ(watchdog.getSlowFrameCount(), 5);
+    GTEST_ASSERT_EQ(reports.size(), 2);
+    GTEST_ASSERT_EQ(reports[0].frame, 3);
+    GTEST_ASSERT_EQ(reports[1].frame, 4);
+
+    watchdog.writeReports(path);
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    GTEST_ASSERT_NE(text.str().find("frame 4: "), std::string::npos);
+    std::remove(path.c_str());
+    EXPECT_THROW(watchdog.writeReports("vazel_missing_dir/slow.txt"),
+                 vazel::core::FrameWatchdogException);
+
+    watchdog.clear();
+    GTEST_ASSERT_EQ(watchdog.getReports().size(), 0);
+}
+
+TEST(FrameWatchdog, App)
+{
+    vazel::core::App &app = vazel::core::App::getInstance();
+    int updates = 0;
+    vazel::core::State state(
+        [](vazel::core::App &) {},
+        [&updates](vazel::core::App &app) {
+            if (++updates == 2) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                app.stop();
+            }
+        },
+        [](vazel::core::App &) {}, 43);
+
+    app.registerState(state);
+    app.watchdog.setBudget(std::chrono::milliseconds(20));
+    app.setState(43);
+    app.run();
+    const std::vector<vazel::core::SlowFrame> reports =
+        app.watchdog.getReports();
+    app.watchdog.setBudget(std::chrono::nanoseconds::zero());
+
+    GTEST_ASSERT_EQ(app.world.getSystemProbe(), nullptr);
+    GTEST_ASSERT_EQ(reports.size(), 1);
+    GTEST_ASSERT_GE(reports[0].duration, std::chrono::milliseconds(30));
+}
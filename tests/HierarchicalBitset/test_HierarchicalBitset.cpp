@@ -0,0 +1,92 @@
+/**
+ * tests/HierarchicalBitset/test_HierarchicalBitset.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/HierarchicalBitset/HierarchicalBitset.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+TEST(HierarchicalBitset, SetAndReset)
+{
+    vazel::ecs::HierarchicalBitset bits;
+
+    GTEST_ASSERT_TRUE(bits.empty());
+    bits.set(3);
+    bits.set(300000);
+    GTEST_ASSERT_TRUE(bits.test(3));
+    GTEST_ASSERT_TRUE(bits.test(300000));
+    GTEST_ASSERT_FALSE(bits.test(4));
+    GTEST_ASSERT_FALSE(bits.test(10000000));
+    GTEST_ASSERT_EQ(bits.count(), 2);
+
+    bits.reset(300000);
+    bits.reset(10000000);
+    GTEST_ASSERT_EQ(bits.count(), 1);
+    bits.reset(3);
+    GTEST_ASSERT_TRUE(bits.empty());
+
+    bits.set(70);
+    bits.clear();
+    GTEST_ASSERT_TRUE(bits.empty());
+    GTEST_ASSERT_FALSE(bits.test(70));
+}
+
+TEST(HierarchicalBitset, ForEach)
+{
+    vazel::ecs::HierarchicalBitset bits;
+    const std::vector<size_t> indices = { 0, 63, 64, 4095, 4096, 262144 };
+    std::vector<size_t> visited;
+
+    for (const size_t it : indices) {
+        bits.set(it);
+    }
+    bits.forEach([&visited](size_t index) { visited.push_back(index); });
+    GTEST_ASSERT_EQ(visited, indices);
+}
+
+TEST(HierarchicalBitset, Join)
+{
+    std::mt19937 rng(42);
+    std::vector<vazel::ecs::HierarchicalBitset> sets(3);
+    std::vector<std::set<size_t>> expected(3);
+    const size_t size[3]  = { 500000, 20000, 300000 };
+    const size_t every[3] = { 2, 3, 50 };
+
+    for (size_t s = 0; s != 3; s++) {
+        for (size_t i = 0; i != size[s]; i++) {
+            if (rng() % every[s] == 0) {
+                sets[s].set(i);
+                expected[s].insert(i);
+            }
+        }
+    }
+    std::vector<size_t> joined;
+    std::vector<size_t> reference;
+    const vazel::ecs::HierarchicalBitset *all[3] = { &sets[0], &sets[1],
+                                                     &sets[2] };
+
+    vazel::ecs::HierarchicalBitset::join(
+        all, [&joined](size_t index) { joined.push_back(index); });
+    for (const size_t it : expected[1]) {
+        if (expected[0].count(it) && expected[2].count(it)) {
+            reference.push_back(it);
+        }
+    }
+    GTEST_ASSERT_FALSE(reference.empty());
+    GTEST_ASSERT_EQ(joined, reference);
+}
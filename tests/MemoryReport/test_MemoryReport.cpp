@@ -0,0 +1,98 @@
+/**
+ * tests/MemoryReport/test_MemoryReport.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+struct memory_payload
+{
+    double values[8];
+};
+
+TEST(MemoryReport, Components)
+{
+    vazel::ecs::World world(std::pmr::new_delete_resource());
+    vazel::ecs::System system("memory");
+
+    world.registerComponent<placeholder_component_1>();
+    world.registerComponent<memory_payload>();
+    for (int i = 0; i != 10; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+
+        world.attachComponent<placeholder_component_1>(e);
+        if (i % 2 == 0) {
+            world.attachComponent<memory_payload>(e);
+        }
+    }
+    system.addDependency(world.getComponentType<memory_payload>());
+    world.registerSystem(system);
+
+    const vazel::ecs::MemoryReport report = world.memoryReport();
+
+    GTEST_ASSERT_EQ(report.components.size(), 2);
+    const vazel::ecs::ComponentMemory &payload = report.components[1];
+    GTEST_ASSERT_EQ(payload.type,
+                    world.getComponentType<memory_payload>());
+    GTEST_ASSERT_EQ(payload.instances, 5);
+    GTEST_ASSERT_EQ(payload.instanceSize, sizeof(memory_payload));
+    GTEST_ASSERT_EQ(payload.payloadBytes, 5 * sizeof(memory_payload));
+    GTEST_ASSERT_GE(payload.heapBytes, payload.payloadBytes);
+    GTEST_ASSERT_GT(payload.slotBytes, 0);
+    GTEST_ASSERT_GT(payload.overheadPerInstance(), 0);
+    GTEST_ASSERT_GT(payload.fragmentation(), 0);
+    GTEST_ASSERT_LT(payload.fragmentation(), 1);
+
+    GTEST_ASSERT_EQ(report.entities.elements, 10);
+    GTEST_ASSERT_EQ(report.entityIndex.elements, 10);
+    GTEST_ASSERT_GE(report.entityIndex.reservedBytes,
+                    report.entityIndex.usedBytes);
+    GTEST_ASSERT_GT(report.entityIndex.usedBytes, 0);
+    GTEST_ASSERT_EQ(report.systems.size(), 1);
+    GTEST_ASSERT_EQ(report.systems[0].name, "system memory");
+    GTEST_ASSERT_EQ(report.systems[0].elements, 5);
+    size_t componentBytes = 0;
+    for (const auto &it : report.components) {
+        componentBytes += it.heapBytes + it.slotBytes;
+    }
+    GTEST_ASSERT_EQ(report.totalBytes(),
+                    componentBytes + report.entities.reservedBytes +
+                        report.entityIndex.reservedBytes +
+                        report.systems[0].reservedBytes);
+    GTEST_ASSERT_EQ(report.arenaReserved, 0);
+
+    std::ostringstream out;
+    out << report;
+    GTEST_ASSERT_NE(out.str().find("system memory"), std::string::npos);
+    GTEST_ASSERT_NE(out.str().find("entity index"), std::string::npos);
+}
+
+TEST(MemoryReport, Arena)
+{
+    vazel::ecs::WorldArena arena;
+    vazel::ecs::World world(arena);
+    vazel::ecs::Entity e = world.createEntity();
+
+    world.attachComponent<memory_payload>(e);
+    const vazel::ecs::MemoryReport report = world.memoryReport();
+
+    GTEST_ASSERT_EQ(report.arenaAllocated, arena.getAllocated());
+    GTEST_ASSERT_GE(report.arenaReserved, report.arenaAllocated);
+    GTEST_ASSERT_EQ(report.components[0].instances, 1);
+}
@@ -0,0 +1,257 @@
+/**
+ * tests/Metrics/test_Metrics.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/profiling/MetricsExporter/MetricsExporter.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+struct placeholder_event
+{
+    int value;
+};
+
+TEST(Metrics, CounterSumsTheThreads)
+{
+    vazel::profiling::Metrics metrics;
+    vazel::profiling::Counter &counter =
+        metrics.counter("test_total", "A counter");
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i != 4; i++) {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j != 1000; j++) {
+                counter.add();
+            }
+        });
+    }
+    for (auto &it : threads) {
+        it.join();
+    }
+    GTEST_ASSERT_EQ(counter.getValue(), 4000);
+    GTEST_ASSERT_EQ(&metrics.counter("test_total", "A counter"), &counter);
+    GTEST_ASSERT_EQ(metrics.size(), 1);
+}
+
+TEST(Metrics, Histogram)
+{
+    vazel::profiling::Metrics metrics;
+    vazel::profiling::Histogram &histogram =
+        metrics.histogram("test_seconds", "A histogram");
+
+    GTEST_ASSERT_EQ(histogram.getQuantile(0.5).count(), 0);
+    for (int i = 0; i != 99; i++) {
+        histogram.observe(std::chrono::microseconds(100));
+    }
+    histogram.observe(std::chrono::milliseconds(10));
+    GTEST_ASSERT_EQ(histogram.getCount(), 100);
+    GTEST_ASSERT_EQ(histogram.getQuantile(0.5),
+                    vazel::profiling::Histogram::getBound(3));
+    GTEST_ASSERT_GE(histogram.getQuantile(1), std::chrono::milliseconds(10));
+    GTEST_ASSERT_LT(histogram.getQuantile(1), std::chrono::milliseconds(20));
+
+    vazel::profiling::Histogram &few =
+        metrics.histogram("test_few_seconds", "A histogram of ten samples");
+
+    for (int i = 0; i != 9; i++) {
+        few.observe(std::chrono::microseconds(100));
+    }
+    few.observe(std::chrono::milliseconds(10));
+    GTEST_ASSERT_GE(few.getQuantile(0.99), std::chrono::milliseconds(10));
+    GTEST_ASSERT_EQ(few.getQuantile(0.9),
+                    vazel::profiling::Histogram::getBound(3));
+}
+
+TEST(Metrics, Prometheus)
+{
+    vazel::profiling::Metrics metrics;
+
+    metrics.counter("test_total", "Two\nlines",
+                    vazel::profiling::metricLabel("name", "a\"b"))
+        .add(2);
+    metrics.gauge("test_gauge", "A gauge").set(1.5);
+    metrics.counter("test_total", "Two\nlines",
+                    vazel::profiling::metricLabel("name", "c"))
+        .add(3);
+    metrics.histogram("test_seconds", "A histogram")
+        .observe(std::chrono::milliseconds(1));
+
+    std::ostringstream out;
+    metrics.writePrometheus(out);
+    const std::string text = out.str();
+
+    GTEST_ASSERT_EQ(text.find("# HELP test_total Two\\nlines\n"
+                              "# TYPE test_total counter\n"
+                              "test_total{name=\"a\\\"b\"} 2\n"
+                              "test_total{name=\"c\"} 3\n"),
+                    0);
+    GTEST_ASSERT_NE(text.find("test_gauge 1.5\n"), std::string::npos);
+    GTEST_ASSERT_NE(text.find("test_seconds_bucket{le=\"0.000524288\"} 0\n"),
+                    std::string::npos);
+    GTEST_ASSERT_NE(text.find("test_seconds_bucket{le=\"0.001048576\"} 1\n"),
+                    std::string::npos);
+    GTEST_ASSERT_NE(text.find("test_seconds_bucket{le=\"+Inf\"} 1\n"),
+                    std::string::npos);
+    GTEST_ASSERT_NE(text.find("test_seconds_count 1\n"), std::string::npos);
+}
+
+TEST(Metrics, InvalidDeclarations)
+{
+    vazel::profiling::Metrics metrics;
+
+    metrics.gauge("test_gauge", "A gauge");
+    EXPECT_THROW(metrics.counter("test_gauge", "A counter"),
+                 vazel::profiling::MetricsException);
+    EXPECT_THROW(metrics.counter("0test", "A counter"),
+                 vazel::profiling::MetricsException);
+    EXPECT_THROW(metrics.counter("test-total", "A counter"),
+                 vazel::profiling::MetricsException);
+}
+
+TEST(Metrics, World)
+{
+    vazel::profiling::Metrics metrics;
+    vazel::ecs::WorldMetrics worldMetrics("test", metrics);
+    vazel::ecs::World world;
+    vazel::ecs::System system("move");
+    std::vector<vazel::ecs::Entity> entities;
+
+    world.registerComponent<placeholder_component_1>();
+    for (int i = 0; i != 5; i++) {
+        entities.push_back(world.createEntity());
+        world.attachComponent<placeholder_component_1>(entities.back());
+    }
+    world.detachComponent<placeholder_component_1>(entities[0]);
+    world.removeEntity(entities[1]);
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    world.registerSystem(system);
+    world.setMetrics(&worldMetrics);
+    world.updateSystem();
+    world.events<placeholder_event>().send({1});
+    world.events<placeholder_event>().send({2});
+    world.updateSystem();
+
+    const std::string world_label = "world=\"test\"";
+    const std::string system_label = world_label + ",system=\"move\"";
+
+    GTEST_ASSERT_EQ(world.getEntityCount(), 4);
+    GTEST_ASSERT_EQ(
+        metrics.gauge("vazel_entities", "", world_label).getValue(), 4);
+    GTEST_ASSERT_EQ(
+        metrics
+            .gauge("vazel_components", "",
+                   world_label + "," +
+                       vazel::profiling::metricLabel(
+                           "component",
+                           typeid(placeholder_component_1).name()))
+            .getValue(),
+        3);
+    GTEST_ASSERT_EQ(
+        metrics.counter("vazel_system_updates_total", "", system_label)
+            .getValue(),
+        2);
+    GTEST_ASSERT_EQ(
+        metrics.gauge("vazel_system_entities", "", system_label).getValue(),
+        3);
+    GTEST_ASSERT_EQ(
+        metrics
+            .gauge("vazel_events_pending", "",
+                   world_label + "," +
+                       vazel::profiling::metricLabel(
+                           "event", typeid(placeholder_event).name()))
+            .getValue(),
+        2);
+    world.setMetrics(nullptr);
+}
+
+TEST(Metrics, ExportFile)
+{
+    vazel::profiling::Metrics metrics;
+    vazel::profiling::MetricsExporter exporter(metrics);
+    const std::string path = "vazel_test_metrics.prom";
+
+    metrics.gauge("test_gauge", "A gauge").set(3);
+    exporter.startFile(path, std::chrono::milliseconds(10));
+    EXPECT_THROW(exporter.startFile(path, std::chrono::milliseconds(10)),
+                 vazel::profiling::MetricsException);
+    while (exporter.getExportCount() < 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    exporter.stop();
+    GTEST_ASSERT_FALSE(exporter.isRunning());
+
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    GTEST_ASSERT_NE(text.str().find("test_gauge 3\n"), std::string::npos);
+    std::remove(path.c_str());
+    EXPECT_THROW(exporter.writeFile("vazel_missing_dir/metrics.prom"),
+                 vazel::profiling::MetricsException);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(Metrics, ExportSocket)
+{
+    vazel::profiling::Metrics metrics;
+    vazel::profiling::MetricsExporter exporter(metrics);
+    const std::string path = "vazel_test_metrics.sock";
+    struct sockaddr_un addr;
+
+    metrics.counter("test_total", "A counter").add(7);
+    exporter.startSocket(path);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    GTEST_ASSERT_EQ(connect(fd, reinterpret_cast<struct sockaddr *>(&addr),
+                            sizeof(addr)),
+                    0);
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    GTEST_ASSERT_EQ(send(fd, request, sizeof(request) - 1, 0),
+                    sizeof(request) - 1);
+
+    std::string response;
+    char buf[256];
+    ssize_t n = 0;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        response.append(buf, n);
+    }
+    close(fd);
+    exporter.stop();
+
+    GTEST_ASSERT_EQ(response.find("HTTP/1.0 200 OK\r\n"), 0);
+    GTEST_ASSERT_NE(response.find("\r\n\r\n# HELP test_total A counter\n"),
+                    std::string::npos);
+    GTEST_ASSERT_NE(response.find("test_total 7\n"), std::string::npos);
+    GTEST_ASSERT_EQ(exporter.getExportCount(), 1);
+    GTEST_ASSERT_NE(access(path.c_str(), F_OK), 0);
+}
+#endif
@@ -0,0 +1,87 @@
+/**
+ * tests/Scratch/test_ScratchArena.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/Scratch/ScratchArena.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(ScratchArena, BumpAndReset)
+{
+    vazel::ecs::ScratchArena arena(1024);
+
+    void *a = arena.allocate(10, 1);
+    void *b = arena.allocate(16, 16);
+    GTEST_ASSERT_NE(a, b);
+    GTEST_ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % 16, 0);
+    GTEST_ASSERT_EQ(arena.getUsed(), 26);
+    GTEST_ASSERT_EQ(arena.getReserved(), 1024);
+
+    // Bigger than a block
+    void *c = arena.allocate(4000, 8);
+    GTEST_ASSERT_NE(c, nullptr);
+    GTEST_ASSERT_GE(arena.getReserved(), 1024 + 4000);
+
+    const size_t reserved = arena.getReserved();
+    arena.reset();
+    GTEST_ASSERT_EQ(arena.getUsed(), 0);
+    GTEST_ASSERT_EQ(arena.allocate(10, 1), a);
+    GTEST_ASSERT_EQ(arena.getReserved(), reserved);
+}
+
+TEST(ScratchArena, ThreadsDoNotShare)
+{
+    vazel::ecs::ScratchArena arena(1024);
+    void *main  = arena.allocate(8, 8);
+    void *other = nullptr;
+
+    std::thread([&] { other = arena.allocate(8, 8); }).join();
+    GTEST_ASSERT_NE(main, other);
+    GTEST_ASSERT_EQ(arena.getReserved(), 2048);
+}
+
+TEST(ScratchArena, WorldResetsAfterUpdate)
+{
+    vazel::ecs::World world;
+    vazel::ecs::System system("placeholder_system");
+    size_t largest = 0;
+
+    world.registerComponent<int>();
+    for (int i = 0; i != 10; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+        world.attachComponent<int>(e, i);
+    }
+    system.addDependency(world.getComponentType<int>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e, &world, &largest) {
+        std::pmr::vector<int> tmp(&world.scratch());
+
+        for (int i = 0; i <= cm.getComponent<int>(e); i++) {
+            tmp.push_back(i);
+        }
+        largest = std::max(largest, tmp.size());
+    });
+    world.registerSystem(system);
+
+    world.updateSystem();
+    GTEST_ASSERT_EQ(largest, 10);
+    GTEST_ASSERT_EQ(world.scratch().getUsed(), 0);
+    const size_t reserved = world.scratch().getReserved();
+    world.updateSystem();
+    GTEST_ASSERT_EQ(world.scratch().getReserved(), reserved);
+}
@@ -0,0 +1,166 @@
+/**
+ * tests/Sim/test_Sim.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/core/FrameWatchdog/FrameWatchdog.hpp"
+#include "Vazel/sim.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(Sim, ParseScenario)
+{
+    std::istringstream in("# comment\n"
+                          "entities 100\n"
+                          "components 3 # trailing comment\n"
+                          "density 2 0.5\n"
+                          "storage 2 paged\n"
+                          "ticks 7\n"
+                          "\n"
+                          "system move 0 1\n"
+                          "system all 0 1 2\n");
+    const vazel::sim::Scenario scenario = vazel::sim::parseScenario(in);
+
+    GTEST_ASSERT_EQ(scenario.entities, 100);
+    GTEST_ASSERT_EQ(scenario.components, 3);
+    GTEST_ASSERT_EQ(scenario.ticks, 7);
+    GTEST_ASSERT_EQ(scenario.density.size(), 3);
+    GTEST_ASSERT_EQ(scenario.density[0], 1);
+    GTEST_ASSERT_EQ(scenario.density[2], 0.5);
+    GTEST_ASSERT_EQ(scenario.storage[0], vazel::ecs::ComponentStorage::Sparse);
+    GTEST_ASSERT_EQ(scenario.storage[2], vazel::ecs::ComponentStorage::Paged);
+    GTEST_ASSERT_EQ(scenario.systems.size(), 2);
+    GTEST_ASSERT_EQ(scenario.systems[1].tag, "all");
+    GTEST_ASSERT_EQ(scenario.systems[1].components.size(), 3);
+}
+
+TEST(Sim, InvalidScenario)
+{
+    std::istringstream unknown("entities 10\nfoo 3\n");
+    std::istringstream undeclared("components 2\nsystem move 0 2\n");
+    std::istringstream empty("system move\n");
+    std::istringstream storage("components 1\nstorage 0 packed\n");
+
+    EXPECT_THROW(vazel::sim::parseScenario(unknown),
+                 vazel::sim::ScenarioException);
+    EXPECT_THROW(vazel::sim::parseScenario(undeclared),
+                 vazel::sim::ScenarioException);
+    EXPECT_THROW(vazel::sim::parseScenario(empty),
+                 vazel::sim::ScenarioException);
+    EXPECT_THROW(vazel::sim::parseScenario(storage),
+                 vazel::sim::ScenarioException);
+    EXPECT_THROW(vazel::sim::loadScenario("vazel_missing_scenario.txt"),
+                 vazel::sim::ScenarioException);
+}
+
+TEST(Sim, RunScenario)
+{
+    std::istringstream in("entities 50\n"
+                          "components 2\n"
+                          "system move 0 1\n"
+                          "system single 1\n");
+    const vazel::sim::Scenario scenario = vazel::sim::parseScenario(in);
+    vazel::ecs::World world;
+
+    vazel::sim::buildScenario(world, scenario);
+    vazel::sim::Runner runner(world);
+    const vazel::sim::SimulationReport report = runner.run(10);
+
+    GTEST_ASSERT_EQ(report.ticks, 10);
+    GTEST_ASSERT_GT(report.ticksPerSecond(), 0);
+    GTEST_ASSERT_EQ(report.systems.size(), 2);
+    GTEST_ASSERT_EQ(report.systems[0].tag, "move");
+    GTEST_ASSERT_GT(report.systems[0].total.count(), 0);
+    GTEST_ASSERT_LE(report.systems[0].max, report.systems[0].total);
+    GTEST_ASSERT_EQ(report.frames.size(), 10);
+    GTEST_ASSERT_LE(report.framePercentile(50), report.framePercentile(100));
+    GTEST_ASSERT_LE(report.framePercentile(100), report.elapsed);
+#if defined(__linux__)
+    GTEST_ASSERT_GT(report.peakMemory, 0);
+#endif
+}
+
+TEST(Sim, OnTick)
+{
+    vazel::ecs::World world;
+    vazel::sim::Runner runner(world);
+    size_t ticks = 0;
+
+    runner.setOnTick([&](vazel::ecs::World &w) {
+        w.createEntity();
+        ticks++;
+    });
+    const vazel::sim::SimulationReport report = runner.run(5);
+
+    GTEST_ASSERT_EQ(ticks, 5);
+    GTEST_ASSERT_EQ(report.frames.size(), 5);
+}
+
+TEST(Sim, PerfCounters)
+{
+    vazel::sim::PerfCounters counters;
+    vazel::sim::PerfSample before;
+    vazel::sim::PerfSample after;
+
+    if (counters.isAvailable() == false) {
+        GTEST_ASSERT_FALSE(counters.read(before));
+        GTEST_SKIP() << "hardware counters are not available";
+    }
+    GTEST_ASSERT_TRUE(counters.read(before));
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i != 100000; i++) {
+        sum = sum + i;
+    }
+    GTEST_ASSERT_TRUE(counters.read(after));
+    GTEST_ASSERT_GE(after.instructions, before.instructions);
+}
+
+TEST(Sim, RunWithPerfCounters)
+{
+    std::istringstream in("entities 10\n"
+                          "system move 0\n");
+    vazel::ecs::World world;
+
+    vazel::sim::buildScenario(world, vazel::sim::parseScenario(in));
+    vazel::sim::Runner runner(world);
+    runner.enablePerfCounters(true);
+    const vazel::sim::SimulationReport report = runner.run(3);
+
+    GTEST_ASSERT_EQ(report.hasPerfCounters,
+                    vazel::sim::PerfCounters().isAvailable());
+    GTEST_ASSERT_EQ(report.systems[0].entities, 10);
+}
+
+TEST(Sim, KeepSystemProbe)
+{
+    std::istringstream in("entities 10\n"
+                          "system move 0\n");
+    vazel::ecs::World world;
+    vazel::core::FrameWatchdog watchdog;
+
+    vazel::sim::buildScenario(world, vazel::sim::parseScenario(in));
+    watchdog.setBudget(std::chrono::nanoseconds(1));
+    watchdog.attach(world);
+    vazel::sim::Runner runner(world);
+    watchdog.beginFrame(world);
+    runner.run(1);
+    watchdog.endFrame(world, 0, std::chrono::milliseconds(1));
+
+    GTEST_ASSERT_EQ(world.getSystemProbe(), &watchdog);
+    GTEST_ASSERT_EQ(watchdog.getReports().size(), 1);
+    GTEST_ASSERT_EQ(watchdog.getReports()[0].systems.size(), 1);
+    watchdog.detach(world);
+}
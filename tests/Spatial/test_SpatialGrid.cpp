@@ -0,0 +1,148 @@
+/**
+ * tests/Spatial/test_SpatialGrid.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/Spatial/SpatialGrid.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+
+TEST(SpatialGrid, InvalidCellSize)
+{
+    EXPECT_THROW(vazel::ecs::SpatialGrid(0), vazel::ecs::SpatialGridException);
+}
+
+TEST(SpatialGrid, QueryRadiusMatchesBruteForce)
+{
+    vazel::ecs::SpatialGrid grid(4);
+    std::map<vazel::ecs::Entity, vazel::ecs::SpatialPoint> points;
+
+    for (int x = -20; x < 20; x += 3) {
+        for (int y = -20; y < 20; y += 3) {
+            vazel::ecs::Entity e;
+            vazel::ecs::SpatialPoint p = { x * 0.7f, y * 1.3f };
+            grid.insert(e, p);
+            points.emplace(e, p);
+        }
+    }
+    std::vector<vazel::ecs::Entity> found;
+    grid.queryRadius({ 1, -2 }, 9.5, found);
+
+    std::set<vazel::UUID> expected;
+    for (auto &it : points) {
+        float dx = it.second.x - 1;
+        float dy = it.second.y + 2;
+        if (dx * dx + dy * dy <= 9.5f * 9.5f) {
+            expected.insert(it.first.getId());
+        }
+    }
+    GTEST_ASSERT_EQ(found.size(), expected.size());
+    for (auto &e : found) {
+        GTEST_ASSERT_EQ(expected.count(e.getId()), 1);
+    }
+}
+
+TEST(SpatialGrid, QueryAABB)
+{
+    vazel::ecs::SpatialGrid grid(1);
+    vazel::ecs::Entity inside;
+    vazel::ecs::Entity outside;
+    std::vector<vazel::ecs::Entity> found;
+
+    grid.insert(inside, { 2.5, 2.5 });
+    grid.insert(outside, { 5, 2.5 });
+    grid.queryAABB({ 0, 0 }, { 3, 3 }, found);
+    GTEST_ASSERT_EQ(found.size(), 1);
+    GTEST_ASSERT_EQ(found[0].getId(), inside.getId());
+}
+
+TEST(SpatialGrid, MoveAndRemove)
+{
+    vazel::ecs::SpatialGrid grid(2);
+    vazel::ecs::Entity e;
+    std::vector<vazel::ecs::Entity> found;
+
+    grid.insert(e, { 0, 0 });
+    EXPECT_THROW(grid.insert(e, { 0, 0 }), vazel::ecs::SpatialGridException);
+    grid.move(e, { 10, 10 });
+    grid.queryRadius({ 0, 0 }, 1, found);
+    GTEST_ASSERT_EQ(found.size(), 0);
+    grid.queryRadius({ 10, 10 }, 1, found);
+    GTEST_ASSERT_EQ(found.size(), 1);
+    grid.remove(e);
+    GTEST_ASSERT_EQ(grid.size(), 0);
+    EXPECT_THROW(grid.remove(e), vazel::ecs::SpatialGridException);
+}
+
+TEST(SpatialGrid, ForEachPairVisitsEveryPairOnce)
+{
+    vazel::ecs::SpatialGrid grid(1);
+    std::vector<std::pair<vazel::ecs::Entity, vazel::ecs::SpatialPoint>> pts;
+
+    for (int i = 0; i != 60; i++) {
+        vazel::ecs::Entity e;
+        vazel::ecs::SpatialPoint p = { (i * 37 % 23) * 0.4f,
+                                       (i * 11 % 17) * 0.6f };
+        grid.insert(e, p);
+        pts.emplace_back(e, p);
+    }
+    size_t expected = 0;
+    for (size_t i = 0; i != pts.size(); i++) {
+        for (size_t j = i + 1; j != pts.size(); j++) {
+            float dx = pts[i].second.x - pts[j].second.x;
+            float dy = pts[i].second.y - pts[j].second.y;
+            expected += dx * dx + dy * dy <= 2.5f * 2.5f;
+        }
+    }
+    std::set<std::pair<vazel::UUID, vazel::UUID>> seen;
+    grid.forEachPair(2.5, [&](const vazel::ecs::Entity &a,
+                              const vazel::ecs::Entity &b) {
+        std::pair<vazel::UUID, vazel::UUID> key =
+            std::minmax(a.getId(), b.getId());
+        GTEST_ASSERT_EQ(seen.count(key), 0);
+        seen.insert(key);
+    });
+    GTEST_ASSERT_EQ(seen.size(), expected);
+}
+
+TEST(SpatialGrid, WorldFollowsPositionComponent)
+{
+    vazel::ecs::World world;
+    vazel::ecs::Entity a = world.createEntity();
+    vazel::ecs::Entity b = world.createEntity();
+    std::vector<vazel::ecs::Entity> found;
+
+    world.registerComponent<placeholder_position_component>();
+    world.attachComponent<placeholder_position_component>(a);
+    world.enableSpatialIndex<placeholder_position_component>(8);
+    world.attachComponent<placeholder_position_component>(b);
+    GTEST_ASSERT_EQ(world.getSpatialIndex().size(), 2);
+
+    world.getComponent<placeholder_position_component>(b).x = 100;
+    world.updateSpatialIndex();
+    world.getSpatialIndex().queryRadius({ 0, 0 }, 5, found);
+    GTEST_ASSERT_EQ(found.size(), 1);
+    GTEST_ASSERT_EQ(found[0].getId(), a.getId());
+
+    world.detachComponent<placeholder_position_component>(a);
+    world.removeEntity(b);
+    GTEST_ASSERT_EQ(world.getSpatialIndex().size(), 0);
+    world.clearWorld();
+    EXPECT_THROW(world.getSpatialIndex(), vazel::ecs::WorldException);
+}
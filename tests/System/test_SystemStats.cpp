@@ -0,0 +1,105 @@
+/**
+ * tests/System/test_SystemStats.cpp
+ * Copyright (c) 2021 Mattis Dalleau <mattis.dalleau@epitech.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/System/SystemStats.hpp"
+#include "Vazel/ecs/World/World.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(SystemStats, Empty)
+{
+    vazel::ecs::SystemStats stats;
+    const vazel::ecs::SystemStatsSnapshot snapshot = stats.snapshot("empty");
+
+    GTEST_ASSERT_EQ(snapshot.tag, "empty");
+    GTEST_ASSERT_EQ(snapshot.calls, 0);
+    GTEST_ASSERT_EQ(snapshot.max.count(), 0);
+}
+
+TEST(SystemStats, Record)
+{
+    vazel::ecs::SystemStats stats;
+
+    for (int i = 1; i <= 100; i++) {
+        stats.record(std::chrono::microseconds(i), i);
+    }
+    const vazel::ecs::SystemStatsSnapshot snapshot = stats.snapshot("s");
+
+    GTEST_ASSERT_EQ(snapshot.calls, 100);
+    GTEST_ASSERT_EQ(snapshot.entities, 100);
+    GTEST_ASSERT_EQ(snapshot.entitiesTotal, 5050);
+    GTEST_ASSERT_EQ(snapshot.last, 100us);
+    GTEST_ASSERT_EQ(snapshot.min, 1us);
+    GTEST_ASSERT_EQ(snapshot.max, 100us);
+    GTEST_ASSERT_EQ(snapshot.p99, 99us);
+    GTEST_ASSERT_EQ(snapshot.avg, 50500ns);
+}
+
+TEST(SystemStats, RollingWindow)
+{
+    vazel::ecs::SystemStats stats;
+
+    for (int i = 0; i != VAZEL_SYSTEM_STATS_SAMPLES; i++) {
+        stats.record(1ms, 1);
+    }
+    for (int i = 0; i != VAZEL_SYSTEM_STATS_SAMPLES; i++) {
+        stats.record(2us, 1);
+    }
+    const vazel::ecs::SystemStatsSnapshot snapshot = stats.snapshot("s");
+
+    GTEST_ASSERT_EQ(snapshot.calls, 2 * VAZEL_SYSTEM_STATS_SAMPLES);
+    GTEST_ASSERT_EQ(snapshot.max, 2us);
+    GTEST_ASSERT_EQ(snapshot.avg, 2us);
+}
+
+TEST(SystemStats, World)
+{
+    vazel::ecs::World world;
+    vazel::ecs::System system("move");
+
+    world.registerComponent<placeholder_component_1>();
+    for (int i = 0; i != 3; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+        placeholder_component_1 data;
+
+        world.attachComponent<placeholder_component_1>(e, data);
+    }
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {});
+    world.registerSystem(system);
+    world.updateSystemsEntities();
+    world.updateSystem();
+    world.updateSystem();
+
+    const std::vector<vazel::ecs::SystemStatsSnapshot> stats =
+        world.systemStats();
+
+#ifdef VAZEL_ENABLE_SYSTEM_STATS
+    GTEST_ASSERT_EQ(stats.size(), 1);
+    GTEST_ASSERT_EQ(stats[0].tag, "move");
+    GTEST_ASSERT_EQ(stats[0].calls, 2);
+    GTEST_ASSERT_EQ(stats[0].entities, 3);
+    GTEST_ASSERT_LE(stats[0].min, stats[0].max);
+    world.removeSystem("move");
+    GTEST_ASSERT_EQ(world.systemStats().size(), 0);
+#else
+    GTEST_ASSERT_EQ(stats.size(), 0);
+#endif
+}
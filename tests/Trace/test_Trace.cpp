@@ -0,0 +1,110 @@
+/**
+ * tests/Trace/test_Trace.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/profiling.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+using vazel::profiling::Tracer;
+
+TEST(Trace, Record)
+{
+    Tracer &tracer = Tracer::getInstance();
+
+    tracer.clear();
+    {
+        vazel::profiling::TraceScope scope("ignored", "test");
+    }
+    GTEST_ASSERT_EQ(tracer.getEventCount(), 0);
+    tracer.start();
+    {
+        vazel::profiling::TraceScope scope("outer", "test");
+        vazel::profiling::TraceScope inner("inner \"quoted\"", "test", 7);
+    }
+    std::thread([] {
+        vazel::profiling::TraceScope scope("worker", "test");
+    }).join();
+    tracer.stop();
+    GTEST_ASSERT_EQ(tracer.getEventCount(), 3);
+
+    std::ostringstream out;
+    tracer.writeChromeTrace(out);
+    const std::string json = out.str();
+
+    GTEST_ASSERT_NE(json.find("\"traceEvents\""), std::string::npos);
+    GTEST_ASSERT_NE(json.find("\"name\":\"outer\""), std::string::npos);
+    GTEST_ASSERT_NE(json.find("\"name\":\"inner \\\"quoted\\\"\""),
+                    std::string::npos);
+    GTEST_ASSERT_NE(json.find("\"args\":{\"id\":7}"), std::string::npos);
+    GTEST_ASSERT_NE(json.find("\"name\":\"worker\""), std::string::npos);
+    tracer.clear();
+    GTEST_ASSERT_EQ(tracer.getEventCount(), 0);
+}
+
+TEST(Trace, RingBuffer)
+{
+    Tracer &tracer = Tracer::getInstance();
+    const auto now = std::chrono::steady_clock::now();
+
+    tracer.clear();
+    for (size_t i = 0; i != VAZEL_TRACE_BUFFER_SIZE + 10; i++) {
+        tracer.record("event", "test", now, now);
+    }
+    GTEST_ASSERT_EQ(tracer.getEventCount(), VAZEL_TRACE_BUFFER_SIZE);
+    tracer.clear();
+}
+
+TEST(Trace, InvalidPath)
+{
+    EXPECT_THROW(Tracer::getInstance().writeChromeTrace(
+                     "/vazel_missing_directory/trace.json"),
+                 vazel::profiling::TraceException);
+}
+
+TEST(Trace, Systems)
+{
+    Tracer &tracer = Tracer::getInstance();
+    vazel::ecs::World world;
+    vazel::ecs::System system("traced_system");
+    vazel::ecs::Entity e = world.createEntity();
+    placeholder_component_1 data;
+
+    world.registerComponent<placeholder_component_1>();
+    world.attachComponent<placeholder_component_1>(e, data);
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {});
+    world.registerSystem(system);
+    world.updateSystemsEntities();
+    tracer.clear();
+    tracer.start();
+    world.updateSystem();
+    tracer.stop();
+
+    std::ostringstream out;
+    tracer.writeChromeTrace(out);
+#ifdef VAZEL_ENABLE_TRACING
+    GTEST_ASSERT_NE(out.str().find("\"name\":\"traced_system\""),
+                    std::string::npos);
+#else
+    GTEST_ASSERT_EQ(tracer.getEventCount(), 0);
+#endif
+    tracer.clear();
+}
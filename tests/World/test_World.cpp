@@ -155,6 +155,36 @@ TEST(World, getComponentFromEntity)
               &world.getComponent<placeholder_position_component>(entity));
 }
 
+TEST(World, getComponentAgainAfterGrowth)
+{
+    for (auto storage :
+         { vazel::ecs::ComponentStorage::Dense,
+           vazel::ecs::ComponentStorage::Sparse,
+           vazel::ecs::ComponentStorage::Paged }) {
+        vazel::ecs::World world;
+        std::vector<vazel::ecs::Entity> entities;
+
+        world.registerComponent<placeholder_position_component>(storage);
+        for (int i = 0; i != 1000; i++) {
+            entities.push_back(world.createEntity());
+            world.attachComponent<placeholder_position_component>(
+                entities.back());
+            world.getComponent<placeholder_position_component>(entities.back())
+                .x = float(i);
+        }
+        // The values moved when the pool grew and when the hole of the
+        // first one was filled, the references are fetched again
+        world.detachComponent<placeholder_position_component>(entities[0]);
+        for (int i = 1; i != 1000; i++) {
+            EXPECT_EQ(world
+                          .getComponent<placeholder_position_component>(
+                              entities[i])
+                          .x,
+                      float(i));
+        }
+    }
+}
+
 TEST(World, registerSystem)
 {
     vazel::ecs::World world;
@@ -233,6 +263,53 @@ TEST(World, removeASystem)
     world.removeSystem("placeholder_system");
 }
 
+TEST(World, swap)
+{
+    vazel::ecs::World world;
+    vazel::ecs::World other;
+    vazel::ecs::System system("placeholder_system");
+
+    world.registerComponent<placeholder_component_1>();
+    vazel::ecs::Entity e = world.createEntity();
+    world.attachComponent<placeholder_component_1>(e);
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    world.registerSystem(system);
+
+    world.swap(other);
+    EXPECT_ANY_THROW(world.getComponent<placeholder_component_1>(e));
+    EXPECT_ANY_THROW(world.removeSystem("placeholder_system"));
+    other.getComponent<placeholder_component_1>(e);
+    other.removeSystem("placeholder_system");
+}
+
+TEST(World, join)
+{
+    vazel::ecs::World world;
+    vazel::ecs::Entity first  = world.createEntity();
+    vazel::ecs::Entity second = world.createEntity();
+    vazel::ecs::Entity third  = world.createEntity();
+    placeholder_position_component position = { 1, 2 };
+    entity_offsetx_offsety offset            = { 3, 4 };
+    size_t count                              = 0;
+
+    world.registerComponent<placeholder_position_component>();
+    world.registerComponent<entity_offsetx_offsety>();
+    world.attachComponent(first, position);
+    world.attachComponent(first, offset);
+    world.attachComponent(second, position);
+    world.attachComponent(third, offset);
+    world.join<placeholder_position_component, entity_offsetx_offsety>(
+        [&](const vazel::ecs::Entity &e, placeholder_position_component &p,
+            entity_offsetx_offsety &o) {
+            GTEST_ASSERT_EQ(e, first);
+            p.x += o.ofx;
+            count++;
+        });
+    GTEST_ASSERT_EQ(count, 1);
+    GTEST_ASSERT_EQ(
+        world.getComponent<placeholder_position_component>(first).x, 4);
+}
+
 /*
 TEST(World, updateSystem)
 {
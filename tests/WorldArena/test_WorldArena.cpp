@@ -0,0 +1,127 @@
+/**
+ * tests/WorldArena/test_WorldArena.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/ecs/WorldArena/WorldArena.hpp"
+
+#include <gtest/gtest.h>
+
+struct Counted
+{
+    int *alive;
+
+    Counted(int *counter)
+        : alive(counter)
+    {
+        (*alive)++;
+    }
+
+    Counted(const Counted &other)
+        : alive(other.alive)
+    {
+        (*alive)++;
+    }
+
+    ~Counted(void)
+    {
+        (*alive)--;
+    }
+};
+
+TEST(WorldArena, AccountsTheWorld)
+{
+    vazel::ecs::WorldArena arena;
+    vazel::ecs::World world(arena);
+    vazel::ecs::System system("placeholder_system");
+    std::vector<vazel::ecs::Entity> entities;
+
+    GTEST_ASSERT_EQ(world.getMemoryResource(), &arena);
+    world.registerComponent<int>();
+    for (int i = 0; i != 100; i++) {
+        entities.push_back(world.createEntity());
+        world.attachComponent<int>(entities.back(), i);
+    }
+    system.addDependency(world.getComponentType<int>());
+    world.registerSystem(system);
+
+    const size_t allocated = arena.getAllocated();
+    GTEST_ASSERT_GT(allocated, 100 * sizeof(int));
+    GTEST_ASSERT_GE(arena.getReserved(), allocated);
+    world.detachComponent<int>(entities[0]);
+    GTEST_ASSERT_LE(arena.getAllocated(), allocated - sizeof(int));
+    GTEST_ASSERT_EQ(world.getComponent<int>(entities[99]), 99);
+
+    world.clearWorld();
+    GTEST_ASSERT_EQ(arena.getAllocated(), 0);
+    GTEST_ASSERT_EQ(arena.getReserved(), 0);
+    GTEST_ASSERT_GE(arena.getPeak(), allocated);
+
+    world.registerComponent<int>();
+    vazel::ecs::Entity e = world.createEntity();
+    world.attachComponent<int>(e);
+    GTEST_ASSERT_EQ(world.getComponent<int>(e), 0);
+    GTEST_ASSERT_GT(arena.getAllocated(), 0);
+}
+
+TEST(WorldArena, Limit)
+{
+    vazel::ecs::WorldArena arena(64 * 1024);
+    vazel::ecs::World world(arena);
+
+    world.registerComponent<int>();
+    EXPECT_ANY_THROW({
+        for (int i = 0; i != 100000; i++) {
+            vazel::ecs::Entity e = world.createEntity();
+            world.attachComponent<int>(e, i);
+        }
+    });
+    GTEST_ASSERT_LE(arena.getReserved(), arena.getLimit());
+}
+
+TEST(WorldArena, ComponentsAreDestroyed)
+{
+    vazel::ecs::WorldArena arena;
+    int alive = 0;
+
+    {
+        vazel::ecs::World world(arena);
+        Counted counted(&alive);
+
+        world.registerComponent<Counted>();
+        for (int i = 0; i != 10; i++) {
+            vazel::ecs::Entity e = world.createEntity();
+            world.attachComponent<Counted>(e, counted);
+        }
+        GTEST_ASSERT_EQ(alive, 11);
+        world.clearWorld();
+        GTEST_ASSERT_EQ(alive, 1);
+        vazel::ecs::Entity e = world.createEntity();
+        world.registerComponent<Counted>();
+        world.attachComponent<Counted>(e, counted);
+    }
+    GTEST_ASSERT_EQ(alive, 0);
+    GTEST_ASSERT_EQ(arena.getAllocated(), 0);
+}
+
+TEST(WorldArena, SwapNeedsTheSameResource)
+{
+    vazel::ecs::WorldArena arena;
+    vazel::ecs::World world(arena);
+    vazel::ecs::World other;
+
+    EXPECT_THROW(world.swap(other), vazel::ecs::WorldException);
+}
@@ -0,0 +1,120 @@
+/**
+ * tests/WorldHost/test_WorldHost.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../tests_components.hpp"
+#include "Vazel/core/WorldHost/WorldHost.hpp"
+
+#include <gtest/gtest.h>
+
+static void _populateWorld(vazel::ecs::World &world, size_t entities)
+{
+    vazel::ecs::System system("move");
+
+    world.registerComponent<placeholder_position_component>();
+    for (size_t i = 0; i != entities; i++) {
+        vazel::ecs::Entity e = world.createEntity();
+        world.attachComponent<placeholder_position_component>(e);
+    }
+    system.addDependency(
+        world.getComponentType<placeholder_position_component>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        cm.getComponent<placeholder_position_component>(e).x += 1;
+    });
+    world.registerSystem(system);
+}
+
+TEST(WorldHost, CreateHost)
+{
+    vazel::core::WorldHost host(2);
+
+    GTEST_ASSERT_EQ(host.workerCount(), 2);
+    GTEST_ASSERT_EQ(host.size(), 0);
+    host.tick();
+}
+
+TEST(WorldHost, TickManyWorlds)
+{
+    vazel::core::WorldHost host(3);
+    std::vector<std::pair<vazel::core::WorldId, vazel::ecs::Entity>> probes;
+
+    for (size_t i = 0; i != 64; i++) {
+        vazel::core::WorldId id  = host.addWorld();
+        vazel::ecs::World &world = host.getWorld(id);
+
+        _populateWorld(world, 10);
+        vazel::ecs::Entity e = world.createEntity();
+        world.attachComponent<placeholder_position_component>(e);
+        probes.emplace_back(id, e);
+    }
+    for (size_t i = 0; i != 10; i++) {
+        host.tick();
+    }
+    for (auto &it : probes) {
+        auto &pos = host.getWorld(it.first)
+                        .getComponent<placeholder_position_component>(
+                            it.second);
+        GTEST_ASSERT_EQ(pos.x, 10);
+        GTEST_ASSERT_EQ(host.getStats(it.first).ticks, 10);
+    }
+}
+
+TEST(WorldHost, RemoveWorldReusesId)
+{
+    vazel::core::WorldHost host(1);
+    vazel::core::WorldId first = host.addWorld();
+
+    host.addWorld();
+    host.removeWorld(first);
+    GTEST_ASSERT_EQ(host.size(), 1);
+    GTEST_ASSERT_EQ(host.addWorld(), first);
+    EXPECT_THROW(host.getWorld(42), vazel::core::WorldHostException);
+}
+
+TEST(WorldHost, FrameBudgetOverruns)
+{
+    vazel::core::WorldHost host(0);
+    vazel::core::WorldId id = host.addWorld(std::chrono::nanoseconds(1));
+
+    _populateWorld(host.getWorld(id), 1000);
+    host.tick();
+    GTEST_ASSERT_EQ(host.getStats(id).overruns, 1);
+    host.setFrameBudget(id, std::chrono::hours(1));
+    host.tick();
+    GTEST_ASSERT_EQ(host.getStats(id).overruns, 1);
+    EXPECT_LE(host.getStats(id).min, host.getStats(id).max);
+}
+
+TEST(WorldHost, ExceptionIsForwarded)
+{
+    vazel::core::WorldHost host(2);
+    vazel::core::WorldId id  = host.addWorld();
+    vazel::ecs::World &world = host.getWorld(id);
+    vazel::ecs::System system("throwing");
+
+    world.registerComponent<placeholder_component_1>();
+    vazel::ecs::Entity e = world.createEntity();
+    world.attachComponent<placeholder_component_1>(e);
+    system.addDependency(world.getComponentType<placeholder_component_1>());
+    system.setOnUpdate(VAZEL_SYSTEM_UPDATE_LAMBDA(cm, e) {
+        throw std::runtime_error("world failure");
+    });
+    world.registerSystem(system);
+    host.addWorld();
+    EXPECT_THROW(host.tick(), std::runtime_error);
+    host.getWorld(id).removeSystem("throwing");
+    host.tick();
+}
@@ -0,0 +1,84 @@
+/**
+ * tests/WorldReaper/test_WorldReaper.cpp
+ * Copyright (c) 2021 Mattis DALLEAU <mattisdalleau@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Vazel/ecs/World/World.hpp"
+#include "Vazel/ecs/WorldReaper/WorldReaper.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+struct DestroyedOn
+{
+    std::thread::id *id;
+
+    ~DestroyedOn(void)
+    {
+        *id = std::this_thread::get_id();
+    }
+};
+
+TEST(WorldReaper, ClearWorldAsync)
+{
+    vazel::ecs::WorldReaper reaper;
+    vazel::ecs::World world;
+    vazel::ecs::System system("placeholder_system");
+    std::thread::id destroyedOn;
+
+    world.registerComponent<std::shared_ptr<DestroyedOn>>();
+    vazel::ecs::Entity e = world.createEntity();
+    {
+        auto tracked = std::make_shared<DestroyedOn>(&destroyedOn);
+
+        world.attachComponent<std::shared_ptr<DestroyedOn>>(e, tracked);
+    }
+    system.addDependency(
+        world.getComponentType<std::shared_ptr<DestroyedOn>>());
+    world.registerSystem(system);
+
+    world.clearWorldAsync(reaper);
+    reaper.wait();
+    GTEST_ASSERT_EQ(reaper.pending(), 0);
+    GTEST_ASSERT_NE(destroyedOn, std::thread::id());
+    GTEST_ASSERT_NE(destroyedOn, std::this_thread::get_id());
+
+    // The world is empty and usable right away
+    EXPECT_ANY_THROW(world.removeSystem("placeholder_system"));
+    world.registerComponent<int>();
+    vazel::ecs::Entity other = world.createEntity();
+    world.attachComponent<int>(other);
+    GTEST_ASSERT_EQ(world.getComponent<int>(other), 0);
+}
+
+TEST(WorldReaper, DestructorDrainsTheQueue)
+{
+    std::thread::id destroyedOn;
+
+    {
+        vazel::ecs::WorldReaper reaper;
+
+        for (int i = 0; i != 4; i++) {
+            auto world = std::make_unique<vazel::ecs::World>();
+
+            world->registerComponent<std::shared_ptr<DestroyedOn>>();
+            vazel::ecs::Entity e = world->createEntity();
+            auto tracked         = std::make_shared<DestroyedOn>(&destroyedOn);
+            world->attachComponent<std::shared_ptr<DestroyedOn>>(e, tracked);
+            reaper.reap(std::move(world));
+        }
+    }
+    GTEST_ASSERT_NE(destroyedOn, std::thread::id());
+}